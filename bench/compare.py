@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""比较 goto-slnx-bench 的 JSON 结果与基线，任一例程变慢超过阈值时返回 1。
+
+用法: compare.py --baseline base-1.json [base-2.json ...] --current current-1.json [current-2.json ...]
+                 [--threshold 0.15] [--metric median|min]
+
+基线与当前结果应在同一台机器上交替运行得到（CI 在同一个 runner 上构建目标分支作为基线）。
+每一侧先取每次运行中该例程的统计量（默认各样本的中位数），再取多次运行之间的中位数，
+单次运行受到的干扰不会直接变成退化。
+"""
+
+import argparse
+import json
+import statistics
+import sys
+
+
+def load(path):
+    with open(path, encoding="utf-8") as file:
+        data = json.load(file)
+    if data.get("schema") != 1:
+        raise SystemExit(f"{path}: 不支持的结果格式")
+    return data
+
+
+def combine(runs, metric):
+    """例程名 -> 多次运行的统计量的中位数；只保留每次运行都有的例程。"""
+    names = set(runs[0]["results"])
+    for run in runs[1:]:
+        names &= set(run["results"])
+    return {name: statistics.median(run["results"][name][metric] for run in runs) for name in names}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="比较微基准结果与基线")
+    parser.add_argument("--baseline", nargs="+", required=True, help="基线的一次或多次运行结果")
+    parser.add_argument("--current", nargs="+", required=True, help="当前版本的一次或多次运行结果")
+    parser.add_argument("--threshold", type=float, default=0.15, help="允许的变慢比例（默认 0.15 即 15%%）")
+    parser.add_argument("--metric", choices=("median", "min"), default="median", help="每次运行取的统计量（默认 median）")
+    args = parser.parse_args()
+
+    baseline_runs = [load(path) for path in args.baseline]
+    current_runs = [load(path) for path in args.current]
+    baseline = combine(baseline_runs, args.metric)
+    current = combine(current_runs, args.metric)
+
+    failed = False
+    print(f"{'例程':<28}{'基线 ns/op':>12}{'当前 ns/op':>12}{'变化':>10}")
+    for name in sorted(baseline, key=list(baseline_runs[0]["results"]).index):
+        base = baseline[name]
+        result = current.get(name)
+        if result is None:
+            print(f"{name:<28}{base:>12.1f}{'缺失':>12}")
+            failed = True
+            continue
+        change = result / base - 1.0
+        regressed = change > args.threshold
+        failed = failed or regressed
+        print(f"{name:<28}{base:>12.1f}{result:>12.1f}{change:>+10.1%}{'  退化' if regressed else ''}")
+
+    print(f"基线 {len(baseline_runs)} 次运行，当前 {len(current_runs)} 次运行，各取 {args.metric} 后再取中位数")
+    if failed:
+        print(f"存在超过 {args.threshold:.0%} 的退化或缺失的例程", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
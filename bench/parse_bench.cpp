@@ -0,0 +1,384 @@
+#include "guid_util.h"
+#include "json_util.h"
+#include "sln_parser.h"
+#include "xml_writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+using namespace gotoslnx;
+
+namespace
+{
+
+    // 语料规模与真实的大型解决方案相当：数千项目、六个解决方案配置、四层文件夹
+    constexpr size_t kProjectCount = 2000;
+    constexpr size_t kFolderCount  = 200;
+    constexpr size_t kSampleCount  = 11;
+    // 每个样本至少执行的次数；单次只有几十纳秒的例程若只跑几千次，计时器精度与调度抖动会淹没结果
+    constexpr size_t kMinOpsPerSample = 1000000;
+
+    constexpr std::string_view kProjectTypes[] = {
+        "{9A19103F-16F7-4668-BE54-9A1E7A4F7556}",
+        "{FAE04EC0-301F-11D3-BF4B-00C04F79EFBC}",
+        "{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}",
+        "{F184B08F-C81C-45F6-A57F-5ABD9991F28F}",
+        "{D954291E-2A0B-460D-934E-DC6B0785DB48}",
+    };
+    constexpr std::string_view kProjectExtensions[] = { ".csproj", ".csproj", ".vcxproj", ".vbproj", ".shproj" };
+    constexpr std::string_view kSolutionConfigs[]   = {
+        "Debug|Any CPU",
+        "Debug|x64",
+        "Debug|x86",
+        "Release|Any CPU",
+        "Release|x64",
+        "Release|x86",
+    };
+
+    struct Corpus
+    {
+        std::vector<std::string> rawLines;      // 带缩进与行尾 \r 的原始行
+        std::vector<std::string> assignments;   // 含 '=' 的配置与嵌套行
+        std::vector<std::string> configValues;  // "Debug|Any CPU" 形式的右值
+        std::vector<std::string> headerLines;   // Project(...) 行
+        std::vector<std::string> configLines;   // ProjectConfigurationPlatforms 行
+        std::vector<std::string> guids;         // 带花括号的大写 GUID
+        std::vector<std::string> folderGuids;   // 解决方案文件夹 GUID
+        std::vector<GuidBytes>   guidBytes;     // guids 解码后的字节
+        std::vector<std::string> attributes;    // 写出时的属性值：项目名、路径与配置，几乎都不需要转义
+        std::string              text;          // 整份语料
+        SolutionData             solution;      // 整份语料解析后的结果
+    };
+
+    uint64_t NextRandom(uint64_t& state)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 33;
+    }
+
+    std::string MakeGuid(uint64_t& state)
+    {
+        // 逐个取值，参数求值顺序不固定会让不同编译器生成不同的语料
+        uint64_t parts[6];
+        for (auto& part : parts) {
+            part = NextRandom(state);
+        }
+        return fmt::format("{{{:08X}-{:04X}-{:04X}-{:04X}-{:08X}{:04X}}}", parts[0] & 0xFFFFFFFF, parts[1] & 0xFFFF, parts[2] & 0xFFFF,
+            parts[3] & 0xFFFF, parts[4] & 0xFFFFFFFF, parts[5] & 0xFFFF);
+    }
+
+    Corpus BuildCorpus()
+    {
+        Corpus   corpus;
+        uint64_t state = 0x5EED;
+
+        std::string text = "Microsoft Visual Studio Solution File, Format Version 12.00\r\n# Visual Studio Version 17\r\n";
+        auto        emit = [&](std::string line) {
+            text += line;
+            text += "\r\n";
+            corpus.rawLines.push_back(std::move(line) + "\r");
+        };
+
+        for (size_t i = 0; i < kFolderCount; ++i) {
+            std::string guid   = MakeGuid(state);
+            std::string header = fmt::format("Project(\"{}\") = \"Folder{}\", \"Folder{}\", \"{}\"", kSolutionFolderTypeGuid, i, i, guid);
+            corpus.headerLines.push_back(header);
+            emit(std::move(header));
+            emit("EndProject");
+            corpus.folderGuids.push_back(guid);
+            corpus.guids.push_back(guid);
+        }
+
+        std::vector<std::string> projectGuids;
+        for (size_t i = 0; i < kProjectCount; ++i) {
+            size_t      type   = NextRandom(state) % std::size(kProjectTypes);
+            std::string guid   = MakeGuid(state);
+            std::string name   = fmt::format("Module{}.Component", i);
+            std::string header = fmt::format("Project(\"{}\") = \"{}\", \"src\\Area{}\\{}\\{}{}\", \"{}\"", kProjectTypes[type], name, i % 37,
+                name, name, kProjectExtensions[type], guid);
+            corpus.headerLines.push_back(header);
+            emit(std::move(header));
+            emit("EndProject");
+            projectGuids.push_back(guid);
+            corpus.guids.push_back(guid);
+        }
+
+        emit("Global");
+        emit("\tGlobalSection(SolutionConfigurationPlatforms) = preSolution");
+        for (auto config : kSolutionConfigs) {
+            emit(fmt::format("\t\t{0} = {0}", config));
+        }
+        emit("\tEndGlobalSection");
+        emit("\tGlobalSection(ProjectConfigurationPlatforms) = postSolution");
+        for (const auto& guid : projectGuids) {
+            for (auto config : kSolutionConfigs) {
+                // 多数项目只有 Any CPU，解决方案平台映射过去
+                std::string target = config.substr(0, config.find('|')) == "Debug" ? "Debug|Any CPU" : "Release|Any CPU";
+                emit(fmt::format("\t\t{}.{}.ActiveCfg = {}", guid, config, target));
+                emit(fmt::format("\t\t{}.{}.Build.0 = {}", guid, config, target));
+                corpus.configValues.push_back(target);
+            }
+        }
+        emit("\tEndGlobalSection");
+        emit("\tGlobalSection(NestedProjects) = preSolution");
+        for (size_t i = 1; i < kFolderCount; ++i) {
+            // 每个文件夹挂在更靠前的文件夹下，形成最深四层左右的树
+            emit(fmt::format("\t\t{} = {}", corpus.folderGuids[i], corpus.folderGuids[(i - 1) / 4]));
+        }
+        for (size_t i = 0; i < projectGuids.size(); ++i) {
+            emit(fmt::format("\t\t{} = {}", projectGuids[i], corpus.folderGuids[i % kFolderCount]));
+        }
+        emit("\tEndGlobalSection");
+        emit("EndGlobal");
+
+        for (const auto& guid : corpus.guids) {
+            DecodeBracedGuid(guid, corpus.guidBytes.emplace_back());
+        }
+        for (const auto& line : corpus.rawLines) {
+            std::string trimmed = Trim(line);
+            if (trimmed.find('=') != std::string::npos && !StartsWith(trimmed, "Project(")) {
+                corpus.assignments.push_back(trimmed);
+            }
+            if (trimmed.find(".ActiveCfg") != std::string::npos || trimmed.find(".Build.0") != std::string::npos) {
+                corpus.configLines.push_back(trimmed);
+            }
+        }
+        corpus.solution = ParseSlnText(text);
+        corpus.text     = std::move(text);
+        for (const auto& project : corpus.solution.projects) {
+            corpus.attributes.push_back(project.name);
+            corpus.attributes.push_back(project.path);
+        }
+        corpus.attributes.insert(corpus.attributes.end(), corpus.configValues.begin(), corpus.configValues.end());
+        // 少量真实存在的需要转义的名称
+        for (size_t i = 0; i < corpus.attributes.size(); i += 1000) {
+            corpus.attributes[i] += " & \"Legacy\" <Tools>";
+        }
+        return corpus;
+    }
+
+    struct Benchmark
+    {
+        const char*             name;
+        size_t                  opsPerPass;
+        std::function<size_t()> pass;  // 返回值累加进校验和，防止结果被优化掉
+    };
+
+    struct Result
+    {
+        std::string         name;
+        double              medianNs = 0;
+        double              minNs    = 0;
+        size_t              ops      = 0;
+        std::vector<double> samples;
+    };
+
+    volatile size_t g_sink = 0;
+
+    Result Measure(const char* name, size_t opsPerPass, const std::function<size_t()>& pass, double minTimeMs)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // 先跑一遍预热并估计单遍耗时，再把每个样本凑到 minTimeMs / kSampleCount 左右，且不少于 kMinOpsPerSample 次
+        auto   start    = Clock::now();
+        size_t checksum = pass();
+        double passMs   = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        size_t passes   = std::max<size_t>(1, static_cast<size_t>(minTimeMs / kSampleCount / std::max(passMs, 1e-3)));
+        passes          = std::max(passes, (kMinOpsPerSample + opsPerPass - 1) / opsPerPass);
+
+        Result result;
+        result.name = name;
+        result.ops  = passes * opsPerPass;
+        for (size_t sample = 0; sample < kSampleCount; ++sample) {
+            start = Clock::now();
+            for (size_t i = 0; i < passes; ++i) {
+                checksum += pass();
+            }
+            double elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            result.samples.push_back(elapsedNs / static_cast<double>(passes * opsPerPass));
+        }
+        g_sink = g_sink + checksum;
+
+        std::vector<double> sorted = result.samples;
+        std::sort(sorted.begin(), sorted.end());
+        result.medianNs = sorted[sorted.size() / 2];
+        result.minNs    = sorted.front();
+        return result;
+    }
+
+    std::vector<Benchmark> MakeBenchmarks(Corpus& corpus)
+    {
+        std::vector<Benchmark> benchmarks;
+        benchmarks.push_back({ "Trim", corpus.rawLines.size(), [&] {
+            size_t total = 0;
+            for (const auto& line : corpus.rawLines) {
+                total += Trim(line).size();
+            }
+            return total;
+        } });
+        benchmarks.push_back({ "SplitOnce", corpus.assignments.size(), [&] {
+            size_t total = 0;
+            for (const auto& line : corpus.assignments) {
+                total += SplitOnce(line, '=').size();
+            }
+            return total;
+        } });
+        benchmarks.push_back({ "SplitConfig", corpus.configValues.size(), [&] {
+            size_t total = 0;
+            for (const auto& value : corpus.configValues) {
+                total += SplitConfig(value).second.size();
+            }
+            return total;
+        } });
+        benchmarks.push_back({ "ParseProjectHeader", corpus.headerLines.size(), [&] {
+            size_t total = 0;
+            for (const auto& line : corpus.headerLines) {
+                total += ParseProjectHeader(line).has_value();
+            }
+            return total;
+        } });
+        // 语料已经解析过一遍，这里每一行都命中已有的映射行，与 Build.0 紧跟 ActiveCfg 的常见情况一致
+        benchmarks.push_back({ "ParseProjectConfiguration", corpus.configLines.size(), [&] {
+            for (const auto& line : corpus.configLines) {
+                ParseProjectConfiguration(line, corpus.solution);
+            }
+            return corpus.solution.configs.projects.size();
+        } });
+        benchmarks.push_back({ "NormalizeGuidForSlnx", corpus.guids.size(), [&] {
+            size_t total = 0;
+            for (const auto& guid : corpus.guids) {
+                total += NormalizeGuidForSlnx(guid).size();
+            }
+            return total;
+        } });
+        benchmarks.push_back({ "DecodeBracedGuid", corpus.guids.size(), [&] {
+            size_t    total = 0;
+            GuidBytes bytes;
+            for (const auto& guid : corpus.guids) {
+                total += DecodeBracedGuid(guid, bytes) ? bytes[0] : 0;
+            }
+            return total;
+        } });
+        benchmarks.push_back({ "EncodeGuidLower", corpus.guidBytes.size(), [&] {
+            size_t total = 0;
+            char   text[kSlnxGuidLength];
+            for (const auto& bytes : corpus.guidBytes) {
+                EncodeGuidLower(bytes, text);
+                total += static_cast<unsigned char>(text[0]);
+            }
+            return total;
+        } });
+        // 与写出时一样，每遍使用新的缓存解析全部文件夹
+        benchmarks.push_back({ "ResolveFolderPath", corpus.folderGuids.size(), [&] {
+            std::unordered_map<std::string, std::string> cache;
+            std::unordered_map<std::string, bool>        visiting;
+            size_t                                       total = 0;
+            for (const auto& guid : corpus.folderGuids) {
+                total += ResolveFolderPath(guid, corpus.solution, cache, visiting).size();
+            }
+            return total;
+        } });
+        benchmarks.push_back({ "XmlEscape", corpus.attributes.size(), [&] {
+            std::string out;
+            for (const auto& value : corpus.attributes) {
+                out.clear();
+                AppendXmlEscaped(out, value);
+            }
+            return out.size();
+        } });
+        benchmarks.push_back({ "XmlEscapeScalar", corpus.attributes.size(), [&] {
+            std::string out;
+            for (const auto& value : corpus.attributes) {
+                out.clear();
+                AppendXmlEscapedScalar(out, value);
+            }
+            return out.size();
+        } });
+        // 以下两项按语料行数计，对比整份解析与只取项目列表、文件夹树的按需解析
+        benchmarks.push_back({ "ParseSlnText", corpus.rawLines.size(), [&] { return ParseSlnText(corpus.text).projects.size(); } });
+        benchmarks.push_back({ "LazySlnNesting", corpus.rawLines.size(), [&] {
+            LazySln sln(corpus.text);
+            return sln.Nesting().nestedProjects.size();
+        } });
+        return benchmarks;
+    }
+
+    std::string FormatResults(const std::vector<Result>& results)
+    {
+        std::string out = "{\n  \"schema\": 1,\n  \"unit\": \"ns/op\",\n";
+        out += "  \"results\": {";
+        for (size_t i = 0; i < results.size(); ++i) {
+            out += i == 0 ? "\n    " : ",\n    ";
+            AppendJsonString(out, results[i].name);
+            out += fmt::format(": {{ \"median\": {:.3f}, \"min\": {:.3f}, \"ops\": {}, \"samples\": [", results[i].medianNs, results[i].minNs,
+                results[i].ops);
+            for (size_t s = 0; s < results[i].samples.size(); ++s) {
+                out += fmt::format("{}{:.3f}", s == 0 ? "" : ", ", results[i].samples[s]);
+            }
+            out += "] }";
+        }
+        out += "\n  }\n}\n";
+        return out;
+    }
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr, "用法: goto-slnx-bench [--json 输出文件] [--filter 名称子串] [--min-time-ms 毫秒]\n");
+    }
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::string jsonPath;
+    std::string filter;
+    double      minTimeMs = 300.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (i + 1 < argc && arg == "--json") {
+            jsonPath = argv[++i];
+        } else if (i + 1 < argc && arg == "--filter") {
+            filter = argv[++i];
+        } else if (i + 1 < argc && arg == "--min-time-ms") {
+            minTimeMs = std::atof(argv[++i]);
+        } else {
+            PrintUsage();
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+
+    Corpus              corpus = BuildCorpus();
+    std::vector<Result> results;
+    for (const auto& benchmark : MakeBenchmarks(corpus)) {
+        if (!filter.empty() && std::string_view(benchmark.name).find(filter) == std::string_view::npos) {
+            continue;
+        }
+        results.push_back(Measure(benchmark.name, benchmark.opsPerPass, benchmark.pass, minTimeMs));
+        fmt::print("{:<28} {:>10.1f} ns/op（最小 {:.1f}，每个样本 {} 次）\n", results.back().name, results.back().medianNs, results.back().minNs,
+            results.back().ops);
+    }
+
+    std::string json = FormatResults(results);
+    if (jsonPath.empty()) {
+        fmt::print("{}", json);
+        return 0;
+    }
+    std::ofstream output(jsonPath, std::ios::binary | std::ios::trunc);
+    output.write(json.data(), static_cast<std::streamsize>(json.size()));
+    if (!output) {
+        std::fprintf(stderr, "写入 %s 失败\n", jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "dependency_graph.h"
+#include "sln_parser.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using namespace gotoslnx;
+
+namespace
+{
+
+    // 单个输入允许的耗时：最小预算 + 字节数 × 每字节预算，可通过环境变量调整
+    struct TimeBudget
+    {
+        double nanosecondsPerByte  = 1000.0;
+        double minimumMilliseconds = 50.0;
+    };
+
+    TimeBudget LoadBudget()
+    {
+        TimeBudget budget;
+        if (const char* value = std::getenv("GOTO_SLNX_FUZZ_NS_PER_BYTE")) {
+            budget.nanosecondsPerByte = std::atof(value);
+        }
+        if (const char* value = std::getenv("GOTO_SLNX_FUZZ_MIN_MS")) {
+            budget.minimumMilliseconds = std::atof(value);
+        }
+        return budget;
+    }
+
+    void ExerciseParser(std::string_view text)
+    {
+        SolutionData data;
+        try {
+            data = ParseSlnText(text);
+        } catch (const std::exception&) {
+            return;
+        }
+
+        std::unordered_map<std::string, std::string> cache;
+        std::unordered_map<std::string, bool>        visiting;
+        for (const auto& project : data.projects) {
+            if (project.isSolutionFolder) {
+                ResolveFolderPath(project.guid, data, cache, visiting);
+            }
+            NormalizeGuidForSlnx(project.guid);
+        }
+
+        DependencyGraph graph = BuildDependencyGraph(data);
+        AnalyzeDependencyGraph(graph);
+
+        // 按需解析走另一套结构扫描，同样要经得起任意输入
+        try {
+            LazySln lazy { std::string(text) };
+            lazy.Nesting();
+            std::move(lazy).Materialize();
+        } catch (const std::exception&) {
+        }
+    }
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* bytes, size_t size)
+{
+    static const TimeBudget budget = LoadBudget();
+
+    auto start = std::chrono::steady_clock::now();
+    ExerciseParser(std::string_view(reinterpret_cast<const char*>(bytes), size));
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    double limitMs = budget.minimumMilliseconds + static_cast<double>(size) * budget.nanosecondsPerByte / 1e6;
+    if (elapsedMs > limitMs) {
+        // 以崩溃的形式上报，libFuzzer 会保存触发性能悬崖的输入
+        std::fprintf(stderr, "性能悬崖: %zu 字节耗时 %.1f ms（上限 %.1f ms，%.1f ns/字节）\n", size, elapsedMs, limitMs,
+            elapsedMs * 1e6 / static_cast<double>(size == 0 ? 1 : size));
+        std::abort();
+    }
+    return 0;
+}
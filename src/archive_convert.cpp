@@ -0,0 +1,211 @@
+#include "archive_convert.h"
+#include "path_rebase.h"
+#include "sln_parser.h"
+#include "slnx_writer.h"
+#include "tar_archive.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        constexpr size_t kProjectsPerTask = 256;
+        // 在途成员数的上限按工作线程数计；已解压待转换与已转换待写出的成员各不超过这个数
+        constexpr size_t kJobsPerWorker = 2;
+
+        struct ArchiveJob
+        {
+            BatchItem   item;
+            std::string memberPath;  // 归档内的 .sln 路径
+            std::string outputPath;  // 输出归档中的 .slnx 路径
+            int64_t     mtime = 0;
+            std::string content;  // 转换后释放
+            SlnxText    text;     // 写出后释放
+            TaskGroup   group;
+            bool        converted = false;  // 受 ArchivePipeline::mutex 保护
+        };
+
+        // 调用线程只在 jobs 尾部追加，写出线程按下标依次取走；deque 追加时已有元素的引用保持有效
+        struct ArchivePipeline
+        {
+            std::mutex              mutex;
+            std::condition_variable changed;
+            std::deque<ArchiveJob>  jobs;
+            size_t                  written   = 0;
+            bool                    inputDone = false;
+            std::exception_ptr      writeFailure;
+        };
+
+        void ConvertMember(ArchiveJob& job, const BatchOptions& options, TaskScheduler& scheduler)
+        {
+            TraceSpan span("ConvertMember", job.memberPath);
+            auto      start = std::chrono::steady_clock::now();
+            try {
+                SolutionData     data = ParseSlnText(job.content);
+                UseForwardSlashes(data);
+                SlnxWriteOptions writeOptions;
+                writeOptions.canonical = options.canonical;
+                writeOptions.runRanges = [&](size_t count, const std::function<void(size_t, size_t)>& fn) {
+                    scheduler.ParallelFor(count, kProjectsPerTask, fn);
+                };
+                job.text         = RenderSlnx(data, writeOptions);
+                job.item.status  = BatchItem::Status::Converted;
+                job.item.elapsed = std::chrono::steady_clock::now() - start;
+            } catch (const std::exception& ex) {
+                job.item.status = BatchItem::Status::Failed;
+                job.item.error  = ex.what();
+            }
+            job.content = std::string();
+        }
+
+        void WriteMembers(ArchivePipeline& pipeline, TarWriter& writer)
+        {
+            SetTraceThreadName("archive writer");
+            try {
+                for (size_t next = 0;; ++next) {
+                    ArchiveJob* job = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lock(pipeline.mutex);
+                        pipeline.changed.wait(
+                            lock, [&] { return next < pipeline.jobs.size() ? pipeline.jobs[next].converted : pipeline.inputDone; });
+                        if (next == pipeline.jobs.size()) {
+                            return;
+                        }
+                        job = &pipeline.jobs[next];
+                    }
+                    if (job->item.status == BatchItem::Status::Converted) {
+                        TraceSpan span("WriteMember", job->outputPath);
+                        writer.Add(job->outputPath, job->mtime, job->text.Views());
+                    }
+                    job->text = SlnxText();
+                    {
+                        std::lock_guard<std::mutex> lock(pipeline.mutex);
+                        pipeline.written = next + 1;
+                    }
+                    pipeline.changed.notify_all();
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(pipeline.mutex);
+                pipeline.writeFailure = std::current_exception();
+            }
+            pipeline.changed.notify_all();
+        }
+
+        void ReadMembers(
+            TarReader& reader, ArchivePipeline& pipeline, const BatchOptions& options, TaskScheduler& scheduler, size_t window)
+        {
+            TarMember member;
+            while (reader.Next(member)) {
+                if (!member.regularFile || !member.path.ends_with(".sln")) {
+                    continue;
+                }
+                // 在途成员已满时先帮着执行最早派发的转换，再等写出线程跟上；只有本线程追加 jobs，读大小不必加锁
+                size_t count = pipeline.jobs.size();
+                if (count >= window) {
+                    scheduler.Wait(pipeline.jobs[count - window].group);
+                    std::unique_lock<std::mutex> lock(pipeline.mutex);
+                    pipeline.changed.wait(lock, [&] { return count - pipeline.written < window * 2 || pipeline.writeFailure; });
+                    if (pipeline.writeFailure) {
+                        return;
+                    }
+                }
+
+                // 内容读完再追加，读取失败时 jobs 里不会留下写出线程永远等不到的成员
+                std::string content;
+                {
+                    TraceSpan span("ReadMember", member.path);
+                    content = reader.ReadContent();
+                }
+                ArchiveJob* job = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(pipeline.mutex);
+                    job = &pipeline.jobs.emplace_back();
+                }
+                job->memberPath  = member.path;
+                job->outputPath  = member.path.substr(0, member.path.size() - 4) + ".slnx";
+                job->mtime       = member.mtime;
+                job->content     = std::move(content);
+                job->item.input  = job->memberPath;
+                job->item.output = job->outputPath;
+                job->item.size   = member.size;
+                scheduler.Spawn(job->group, [job, &pipeline, &options, &scheduler] {
+                    ConvertMember(*job, options, scheduler);
+                    {
+                        std::lock_guard<std::mutex> lock(pipeline.mutex);
+                        job->converted = true;
+                    }
+                    pipeline.changed.notify_all();
+                });
+            }
+        }
+
+    }  // namespace
+
+    std::vector<BatchItem> ConvertArchive(
+        const fs::path& input, const fs::path& output, const BatchOptions& options, TaskScheduler& scheduler)
+    {
+        TarReader                reader(input);
+        std::optional<TarWriter> writer;
+        writer.emplace(output);
+
+        ArchivePipeline    pipeline;
+        std::exception_ptr failure;
+        std::thread        writerThread([&pipeline, &writer] { WriteMembers(pipeline, *writer); });
+        try {
+            ReadMembers(reader, pipeline, options, scheduler, std::max<size_t>(2, scheduler.WorkerCount() * kJobsPerWorker));
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        // 派发出去的任务引用着 pipeline 中的成员，全部完成后才能收尾
+        for (auto& job : pipeline.jobs) {
+            scheduler.Wait(job.group);
+        }
+        {
+            std::lock_guard<std::mutex> lock(pipeline.mutex);
+            pipeline.inputDone = true;
+        }
+        pipeline.changed.notify_all();
+        writerThread.join();
+
+        if (!failure) {
+            failure = pipeline.writeFailure;
+        }
+        if (!failure) {
+            try {
+                writer->Finish();
+            } catch (...) {
+                failure = std::current_exception();
+            }
+        }
+        if (failure) {
+            // 不留下不完整的输出归档
+            writer.reset();
+            std::error_code ec;
+            fs::remove(output, ec);
+            std::rethrow_exception(failure);
+        }
+
+        std::vector<BatchItem> items;
+        items.reserve(pipeline.jobs.size());
+        for (auto& job : pipeline.jobs) {
+            items.push_back(std::move(job.item));
+        }
+        return items;
+    }
+
+}  // namespace gotoslnx
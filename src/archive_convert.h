@@ -0,0 +1,19 @@
+#pragma once
+
+#include "batch_convert.h"
+#include "work_stealing.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 逐个读出 .tar/.tar.gz 中的 .sln 并在内存中转换，结果以同一路径的 .slnx 写入输出归档（.tar，或以 .gz/.tgz 结尾时压缩），
+    // 其余成员不写出。解压、转换与压缩写出是流水线：调用线程解压并派发转换任务，写出线程按归档中的顺序取走结果，
+    // 在途成员数有上限，吞吐取决于最慢的一段。结果顺序与归档一致，input/output 为归档内路径；单个成员失败不影响其他成员。
+    // options 中只有 canonical 生效，其余选项依赖磁盘上的文件
+    std::vector<BatchItem> ConvertArchive(const std::filesystem::path& input, const std::filesystem::path& output,
+        const BatchOptions& options, TaskScheduler& scheduler);
+
+}  // namespace gotoslnx
@@ -0,0 +1,216 @@
+#include "batch_convert.h"
+#include "path_rebase.h"
+#include "sln_parser.h"
+#include "slnx_writer.h"
+#include "solution_snapshot.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+#include <fmt/format.h>
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        // 每个子任务处理的项目数；太小时任务调度开销会超过规则计算本身
+        constexpr size_t kProjectsPerTask = 256;
+        constexpr size_t kStatsPerTask    = 64;
+        // 达到这个大小的 .sln 整体读入，ProjectConfigurationPlatforms 切块后交给其他工作线程解析
+        constexpr uintmax_t kParallelParseSize = 8 * 1024 * 1024;
+
+        constexpr std::string_view kHistoryHeader = "goto-slnx-history 1";
+
+        template <typename T>
+        bool ParseNumber(std::string_view text, T& value)
+        {
+            auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            return ec == std::errc() && end == text.data() + text.size();
+        }
+
+        // 小文件流式逐行解析，内存只与项目数有关；大文件的解析是批量转换的长尾，拆开并行
+        SolutionData ParseBatchInput(const BatchItem& item, TaskScheduler& scheduler)
+        {
+            if (item.size < kParallelParseSize || scheduler.WorkerCount() < 2) {
+                return ParseSln(item.input);
+            }
+            return LazySln(item.input).Materialize([&](size_t count, const std::function<void(size_t, size_t)>& fn) {
+                scheduler.ParallelFor(count, 1, fn);
+            });
+        }
+
+        void ConvertOne(BatchItem& item, const BatchOptions& options, DirectoryListingCache& cache, TaskScheduler& scheduler)
+        {
+            std::string inputText = item.input.string();
+            TraceSpan   span("ConvertOne", inputText);
+
+            item.output = item.input;
+            item.output.replace_extension(".slnx");
+            if (!options.force && fs::exists(item.output)) {
+                item.status = BatchItem::Status::Skipped;
+                return;
+            }
+            auto start = std::chrono::steady_clock::now();
+            try {
+                std::string  snapshotWarning;
+                SolutionData data = options.snapshot ? ParseSlnWithSnapshot(item.input, snapshotWarning) : ParseBatchInput(item, scheduler);
+                if (!snapshotWarning.empty()) {
+                    item.warnings.push_back(std::move(snapshotWarning));
+                }
+                if (options.fixPathCase) {
+                    FixPathCase(data, item.input.parent_path(), cache, scheduler);
+                }
+                if (options.checkItems) {
+                    for (const auto& missing :
+                        CheckSolutionItems(data, item.input.parent_path(), *options.checkItems, cache, scheduler)) {
+                        item.warnings.push_back(DescribeMissingItem(data, missing, *options.checkItems));
+                    }
+                }
+                UseForwardSlashes(data);
+                SlnxWriteOptions writeOptions;
+                writeOptions.canonical = options.canonical;
+                writeOptions.runRanges = [&](size_t count, const std::function<void(size_t, size_t)>& fn) {
+                    scheduler.ParallelFor(count, kProjectsPerTask, fn);
+                };
+                WriteSlnx(item.output, data, writeOptions);
+                item.status = BatchItem::Status::Converted;
+                // 任务内部的 Wait 只执行本文件派生的子任务，这段时间里没有混入其他文件的转换，可以直接记入耗时历史
+                item.elapsed = std::chrono::steady_clock::now() - start;
+            } catch (const std::exception& ex) {
+                item.status = BatchItem::Status::Failed;
+                item.error  = ex.what();
+            }
+        }
+
+    }  // namespace
+
+    std::vector<fs::path> FindSolutionFiles(const fs::path& root)
+    {
+        if (!fs::is_directory(root)) {
+            throw std::runtime_error(fmt::format("批量转换的输入不是目录: {}", root.string()));
+        }
+        std::vector<fs::path> files;
+        std::error_code       ec;
+        for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end; !ec && it != end;
+            it.increment(ec)) {
+            if (it->path().extension() == ".sln" && it->is_regular_file(ec)) {
+                files.push_back(it->path());
+            }
+        }
+        if (ec) {
+            throw std::runtime_error(fmt::format("遍历目录失败: {}: {}", root.string(), ec.message()));
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    BatchHistory LoadBatchHistory(const fs::path& path)
+    {
+        BatchHistory  history;
+        std::ifstream input(path, std::ios::binary);
+        std::string   line;
+        if (!input || !std::getline(input, line) || line != kHistoryHeader) {
+            return history;
+        }
+        // 每行: 大小 \t 纳秒 \t 相对路径
+        while (std::getline(input, line)) {
+            size_t first  = line.find('\t');
+            size_t second = first == std::string::npos ? first : line.find('\t', first + 1);
+            if (second == std::string::npos) {
+                continue;
+            }
+            BatchHistory::Entry entry;
+            std::string_view    view(line);
+            if (ParseNumber(view.substr(0, first), entry.size)
+                && ParseNumber(view.substr(first + 1, second - first - 1), entry.nanoseconds)) {
+                history.entries[line.substr(second + 1)] = entry;
+            }
+        }
+        return history;
+    }
+
+    void SaveBatchHistory(const fs::path& path, const BatchHistory& history)
+    {
+        std::string content(kHistoryHeader);
+        content.push_back('\n');
+        for (const auto& [key, entry] : history.entries) {
+            content += fmt::format("{}\t{}\t{}\n", entry.size, entry.nanoseconds, key);
+        }
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output.write(content.data(), static_cast<std::streamsize>(content.size()));
+        if (!output) {
+            throw std::runtime_error(fmt::format("写入耗时历史失败: {}", path.string()));
+        }
+    }
+
+    std::vector<BatchItem> ConvertBatch(const fs::path& root, const std::vector<fs::path>& inputs, const BatchOptions& options,
+        BatchHistory& history, TaskScheduler& scheduler)
+    {
+        std::vector<BatchItem>   items(inputs.size());
+        std::vector<std::string> keys(inputs.size());
+        // 大目录树或网络盘上逐个 stat 很慢，先并行取大小
+        scheduler.ParallelFor(inputs.size(), kStatsPerTask, [&](size_t begin, size_t end) {
+            TraceSpan span("StatInputs");
+            for (size_t index = begin; index < end; ++index) {
+                std::error_code ec;
+                items[index].input = inputs[index];
+                items[index].size  = fs::file_size(inputs[index], ec);
+                if (ec) {
+                    items[index].size = 0;
+                }
+                keys[index] = inputs[index].lexically_relative(root).generic_string();
+            }
+        });
+
+        // 用历史中的总耗时 / 总字节数把大小换算成时间；大小未变的文件直接用上次的实测耗时
+        double totalBytes = 0;
+        double totalNanos = 0;
+        for (const auto& [key, entry] : history.entries) {
+            totalBytes += static_cast<double>(entry.size);
+            totalNanos += static_cast<double>(entry.nanoseconds);
+        }
+        const double nanosPerByte = totalBytes > 0 && totalNanos > 0 ? totalNanos / totalBytes : 1.0;
+
+        std::vector<double> cost(items.size());
+        for (size_t index = 0; index < items.size(); ++index) {
+            auto found  = history.entries.find(keys[index]);
+            cost[index] = found != history.entries.end() && found->second.size == items[index].size
+                ? static_cast<double>(found->second.nanoseconds)
+                : static_cast<double>(items[index].size) * nanosPerByte;
+        }
+        std::vector<size_t> order(items.size());
+        std::iota(order.begin(), order.end(), size_t { 0 });
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return cost[a] > cost[b]; });
+
+        // 窃取从队列顶部（最早提交的一端）取任务，按开销从大到小提交，空闲线程最先拿到最大的文件
+        DirectoryListingCache cache;
+        TaskGroup             group;
+        for (size_t index : order) {
+            scheduler.Spawn(group, [&items, index, &options, &cache, &scheduler] { ConvertOne(items[index], options, cache, scheduler); });
+        }
+        scheduler.Wait(group);
+
+        // 只保留本次仍存在的文件；未转换的沿用旧记录
+        BatchHistory updated;
+        for (size_t index = 0; index < items.size(); ++index) {
+            if (items[index].status == BatchItem::Status::Converted) {
+                updated.entries[keys[index]] = { items[index].size, static_cast<uint64_t>(items[index].elapsed.count()) };
+            } else if (auto found = history.entries.find(keys[index]); found != history.entries.end()) {
+                updated.entries.insert(*found);
+            }
+        }
+        history = std::move(updated);
+        return items;
+    }
+
+}  // namespace gotoslnx
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "solution_items.h"
+#include "work_stealing.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    struct BatchItem
+    {
+        enum class Status
+        {
+            Converted,
+            Skipped,
+            Failed,
+        };
+
+        std::filesystem::path    input;
+        std::filesystem::path    output;
+        Status                   status = Status::Failed;
+        std::string              error;
+        std::vector<std::string> warnings;
+        uintmax_t                size = 0;
+        std::chrono::nanoseconds elapsed { 0 };
+    };
+
+    struct BatchOptions
+    {
+        bool                             force       = false;  // 覆盖已存在的 .slnx
+        bool                             canonical   = false;  // 见 SlnxWriteOptions::canonical
+        bool                             snapshot    = false;  // 复用或刷新各 .sln 旁的解析快照
+        bool                             fixPathCase = false;  // 路径改为磁盘上的实际大小写
+        std::optional<MissingItemPolicy> checkItems;           // 为空时不检查解决方案项
+    };
+
+    // 上次批量转换各文件的大小与耗时，键为相对批量根目录的路径
+    struct BatchHistory
+    {
+        struct Entry
+        {
+            uintmax_t size        = 0;
+            uint64_t  nanoseconds = 0;
+        };
+
+        std::map<std::string, Entry> entries;
+    };
+
+    // 耗时历史保存在批量根目录下的这个文件中
+    inline constexpr const char* kBatchHistoryFile = ".goto-slnx-history";
+
+    // 文件不存在或无法识别时返回空历史
+    BatchHistory LoadBatchHistory(const std::filesystem::path& path);
+    void         SaveBatchHistory(const std::filesystem::path& path, const BatchHistory& history);
+
+    // 递归查找目录下的全部 .sln，按路径排序
+    std::vector<std::filesystem::path> FindSolutionFiles(const std::filesystem::path& root);
+
+    // 每个 .sln 就地转换为同名 .slnx，结果顺序与输入一致；单个文件失败不影响其他文件。
+    // 每个文件是一个任务，按估计开销从大到小派发，大解决方案的配置规则再按项目区间拆成子任务，由空闲线程窃取。
+    // 开销按文件大小估计，并用 history 中的实测耗时修正；转换成功的文件会把本次耗时写回 history。
+    // 检查路径时全部解决方案共用一份目录索引
+    std::vector<BatchItem> ConvertBatch(const std::filesystem::path& root, const std::vector<std::filesystem::path>& inputs,
+        const BatchOptions& options, BatchHistory& history, TaskScheduler& scheduler);
+
+}  // namespace gotoslnx
@@ -0,0 +1,109 @@
+#include "canonical_order.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <string_view>
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        // 区间小于此值时改用比较排序，分桶的固定开销不划算
+        constexpr uint32_t kSmallRange = 32;
+
+        struct SortRange
+        {
+            uint32_t begin;
+            uint32_t end;
+            uint32_t depth;  // 区间内字符串前 depth 个字节都相同
+        };
+
+    }  // namespace
+
+    std::vector<uint32_t> RankStrings(const StringPool& pool)
+    {
+        const uint32_t        count = static_cast<uint32_t>(pool.Size());
+        std::vector<uint32_t> order(count);
+        std::vector<uint32_t> scratch(count);
+        std::iota(order.begin(), order.end(), 0u);
+
+        // 用显式栈代替递归，超长的公共前缀也不会耗尽调用栈
+        std::vector<SortRange> stack;
+        if (count > 1) {
+            stack.push_back({ 0, count, 0 });
+        }
+        while (!stack.empty()) {
+            SortRange range = stack.back();
+            stack.pop_back();
+
+            if (range.end - range.begin < kSmallRange) {
+                std::sort(order.begin() + range.begin, order.begin() + range.end, [&](uint32_t a, uint32_t b) {
+                    return pool.View(a).substr(range.depth) < pool.View(b).substr(range.depth);
+                });
+                continue;
+            }
+
+            // 桶 0 放在 depth 处已经结束的字符串，其余按该字节分桶
+            std::array<uint32_t, 258> offsets {};
+            for (uint32_t i = range.begin; i < range.end; ++i) {
+                std::string_view text = pool.View(order[i]);
+                ++offsets[text.size() > range.depth ? static_cast<unsigned char>(text[range.depth]) + 2 : 1];
+            }
+            offsets[0] = range.begin;
+            for (size_t bucket = 1; bucket < offsets.size(); ++bucket) {
+                offsets[bucket] += offsets[bucket - 1];
+            }
+            std::array<uint32_t, 258> bucketStart = offsets;
+            for (uint32_t i = range.begin; i < range.end; ++i) {
+                std::string_view text   = pool.View(order[i]);
+                size_t           bucket = text.size() > range.depth ? static_cast<unsigned char>(text[range.depth]) + 1 : 0;
+                scratch[offsets[bucket]++] = order[i];
+            }
+            std::copy(scratch.begin() + range.begin, scratch.begin() + range.end, order.begin() + range.begin);
+
+            // 驻留表中没有重复字符串，桶 0 至多一个元素，不必继续
+            for (size_t bucket = 1; bucket < 257; ++bucket) {
+                if (bucketStart[bucket + 1] - bucketStart[bucket] > 1) {
+                    stack.push_back({ bucketStart[bucket], bucketStart[bucket + 1], range.depth + 1 });
+                }
+            }
+        }
+
+        std::vector<uint32_t> rank(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            rank[order[i]] = i;
+        }
+        return rank;
+    }
+
+    std::vector<uint32_t> StableOrderByKey(const std::vector<uint32_t>& keys)
+    {
+        const uint32_t        count = static_cast<uint32_t>(keys.size());
+        std::vector<uint32_t> order(count);
+        std::iota(order.begin(), order.end(), 0u);
+        if (std::is_sorted(keys.begin(), keys.end())) {
+            return order;
+        }
+
+        uint32_t              maxKey = *std::max_element(keys.begin(), keys.end());
+        std::vector<uint32_t> scratch(count);
+        for (uint32_t shift = 0; shift < 32 && (shift == 0 || (maxKey >> shift) != 0); shift += 16) {
+            std::vector<uint32_t> offsets(65537, 0);
+            for (uint32_t index : order) {
+                ++offsets[((keys[index] >> shift) & 0xFFFF) + 1];
+            }
+            for (size_t bucket = 1; bucket < offsets.size(); ++bucket) {
+                offsets[bucket] += offsets[bucket - 1];
+            }
+            for (uint32_t index : order) {
+                scratch[offsets[(keys[index] >> shift) & 0xFFFF]++] = index;
+            }
+            order.swap(scratch);
+        }
+        return order;
+    }
+
+}  // namespace gotoslnx
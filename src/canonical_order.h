@@ -0,0 +1,17 @@
+#pragma once
+
+#include "string_pool.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 按字节序给驻留表中的每个 id 排名（MSD 基数排序），结果与平台、区域设置无关
+    std::vector<uint32_t> RankStrings(const StringPool& pool);
+
+    // 返回按 keys 升序稳定排列的下标（LSD 基数排序，每趟 16 位）；已经有序时直接返回原顺序
+    std::vector<uint32_t> StableOrderByKey(const std::vector<uint32_t>& keys);
+
+}  // namespace gotoslnx
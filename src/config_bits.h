@@ -0,0 +1,110 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 以 64 位字存放的定长位集，按解决方案配置编号索引；超出 Size() 的高位始终为 0
+    class ConfigBits
+    {
+    public:
+        ConfigBits() = default;
+        explicit ConfigBits(size_t size) : m_size(size), m_words((size + 63) / 64, 0) { }
+
+        size_t Size() const { return m_size; }
+        bool   Test(size_t index) const { return (m_words[index / 64] >> (index % 64)) & 1; }
+        void   Set(size_t index) { m_words[index / 64] |= uint64_t(1) << (index % 64); }
+
+        bool Any() const
+        {
+            for (uint64_t word : m_words) {
+                if (word != 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool All() const { return Count() == m_size; }
+
+        size_t Count() const
+        {
+            size_t count = 0;
+            for (uint64_t word : m_words) {
+                count += std::popcount(word);
+            }
+            return count;
+        }
+
+        // mask 中的位是否全部置位
+        bool Covers(const ConfigBits& mask) const
+        {
+            for (size_t w = 0; w < m_words.size(); ++w) {
+                if ((m_words[w] & mask.m_words[w]) != mask.m_words[w]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool Intersects(const ConfigBits& other) const
+        {
+            for (size_t w = 0; w < m_words.size(); ++w) {
+                if ((m_words[w] & other.m_words[w]) != 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        ConfigBits& operator|=(const ConfigBits& other)
+        {
+            for (size_t w = 0; w < m_words.size(); ++w) {
+                m_words[w] |= other.m_words[w];
+            }
+            return *this;
+        }
+
+        ConfigBits& operator&=(const ConfigBits& other)
+        {
+            for (size_t w = 0; w < m_words.size(); ++w) {
+                m_words[w] &= other.m_words[w];
+            }
+            return *this;
+        }
+
+        ConfigBits operator~() const
+        {
+            ConfigBits result(m_size);
+            for (size_t w = 0; w < m_words.size(); ++w) {
+                result.m_words[w] = ~m_words[w];
+            }
+            if (m_size % 64 != 0) {
+                result.m_words.back() &= (uint64_t(1) << (m_size % 64)) - 1;
+            }
+            return result;
+        }
+
+        // 依次回调每个置位的下标
+        template <typename Fn>
+        void ForEach(Fn&& fn) const
+        {
+            for (size_t w = 0; w < m_words.size(); ++w) {
+                for (uint64_t word = m_words[w]; word != 0; word &= word - 1) {
+                    fn(w * 64 + std::countr_zero(word));
+                }
+            }
+        }
+
+        friend bool operator==(const ConfigBits&, const ConfigBits&) = default;
+
+    private:
+        size_t                m_size = 0;
+        std::vector<uint64_t> m_words;
+    };
+
+}  // namespace gotoslnx
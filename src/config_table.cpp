@@ -0,0 +1,148 @@
+#include "config_table.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        uint64_t RowKey(uint32_t project, uint32_t solutionConfig)
+        {
+            return (static_cast<uint64_t>(project) << 32) | solutionConfig;
+        }
+
+        template <typename T>
+        void Permute(std::vector<T>& column, const std::vector<uint32_t>& order)
+        {
+            std::vector<T> sorted(column.size());
+            for (size_t i = 0; i < order.size(); ++i) {
+                sorted[i] = column[order[i]];
+            }
+            column = std::move(sorted);
+        }
+
+    }  // namespace
+
+    std::pair<uint32_t, bool> ConfigMappingTable::Upsert(uint32_t project, uint32_t solutionConfig)
+    {
+        // 同一项目同一配置的 ActiveCfg / Build.0 / Deploy.0 通常相邻出现
+        uint32_t last = static_cast<uint32_t>(Size()) - 1;
+        if (!projects.empty() && projects[last] == project && solutionConfigs[last] == solutionConfig) {
+            return { last, false };
+        }
+
+        if (project != m_currentProject) {
+            m_currentProject = project;
+            m_currentRows.clear();
+        }
+        if (uint32_t sealed = Find(project, solutionConfig); sealed != kNoRow) {
+            return { sealed, false };
+        }
+        auto [iter, inserted] = m_currentRows.emplace(solutionConfig, static_cast<uint32_t>(Size()));
+        if (inserted) {
+            projects.push_back(project);
+            solutionConfigs.push_back(solutionConfig);
+            buildTypes.push_back(StringPool::kNone);
+            platforms.push_back(StringPool::kNone);
+            flags.push_back(0);
+        }
+        return { iter->second, inserted };
+    }
+
+    void ConfigMappingTable::Seal(size_t projectCount)
+    {
+        m_currentProject = kNoRow;
+        m_currentRows    = {};
+
+        // 稳定排序让重复行保持到达顺序
+        auto less = [&](uint32_t a, uint32_t b) {
+            return RowKey(projects[a], solutionConfigs[a]) < RowKey(projects[b], solutionConfigs[b]);
+        };
+        std::vector<uint32_t> order(Size());
+        std::iota(order.begin(), order.end(), 0u);
+        if (!std::is_sorted(order.begin(), order.end(), less)) {
+            std::stable_sort(order.begin(), order.end(), less);
+            Permute(projects, order);
+            Permute(solutionConfigs, order);
+            Permute(buildTypes, order);
+            Permute(platforms, order);
+            Permute(flags, order);
+        }
+
+        // 合并重复行：标志取并集，项目配置与平台取最后一个有 ActiveCfg 的行
+        size_t kept = 0;
+        for (size_t row = 0; row < Size(); ++row) {
+            if (kept != 0 && projects[kept - 1] == projects[row] && solutionConfigs[kept - 1] == solutionConfigs[row]) {
+                if (flags[row] & kMappingActive) {
+                    buildTypes[kept - 1] = buildTypes[row];
+                    platforms[kept - 1]  = platforms[row];
+                }
+                flags[kept - 1] |= flags[row];
+                continue;
+            }
+            projects[kept]        = projects[row];
+            solutionConfigs[kept] = solutionConfigs[row];
+            buildTypes[kept]      = buildTypes[row];
+            platforms[kept]       = platforms[row];
+            flags[kept]           = flags[row];
+            ++kept;
+        }
+        projects.resize(kept);
+        solutionConfigs.resize(kept);
+        buildTypes.resize(kept);
+        platforms.resize(kept);
+        flags.resize(kept);
+
+        m_projectOffsets.assign(projectCount + 1, 0);
+        for (uint32_t project : projects) {
+            ++m_projectOffsets[project + 1];
+        }
+        std::partial_sum(m_projectOffsets.begin(), m_projectOffsets.end(), m_projectOffsets.begin());
+
+        m_slotConfigs = solutionConfigs;
+        std::sort(m_slotConfigs.begin(), m_slotConfigs.end());
+        m_slotConfigs.erase(std::unique(m_slotConfigs.begin(), m_slotConfigs.end()), m_slotConfigs.end());
+
+        m_active.assign(projectCount, ConfigBits(SlotCount()));
+        m_build.assign(projectCount, ConfigBits(SlotCount()));
+        m_deploy.assign(projectCount, ConfigBits(SlotCount()));
+        for (uint32_t row = 0; row < Size(); ++row) {
+            uint32_t slot = Slot(solutionConfigs[row]);
+            if (flags[row] & kMappingActive) {
+                m_active[projects[row]].Set(slot);
+            }
+            if (flags[row] & kMappingBuild) {
+                m_build[projects[row]].Set(slot);
+            }
+            if (flags[row] & kMappingDeploy) {
+                m_deploy[projects[row]].Set(slot);
+            }
+        }
+        // 没有 ActiveCfg 的配置不参与构建与部署
+        for (size_t project = 0; project < projectCount; ++project) {
+            m_build[project] &= m_active[project];
+            m_deploy[project] &= m_active[project];
+        }
+    }
+
+    uint32_t ConfigMappingTable::Slot(uint32_t solutionConfig) const
+    {
+        auto found = std::lower_bound(m_slotConfigs.begin(), m_slotConfigs.end(), solutionConfig);
+        return found != m_slotConfigs.end() && *found == solutionConfig ? static_cast<uint32_t>(found - m_slotConfigs.begin()) : kNoRow;
+    }
+
+    uint32_t ConfigMappingTable::Find(uint32_t project, uint32_t solutionConfig) const
+    {
+        if (project + 1 >= m_projectOffsets.size() || solutionConfig == StringPool::kNone) {
+            return kNoRow;
+        }
+        auto begin = solutionConfigs.begin() + Begin(project);
+        auto end   = solutionConfigs.begin() + End(project);
+        auto found = std::lower_bound(begin, end, solutionConfig);
+        return found != end && *found == solutionConfig ? static_cast<uint32_t>(found - solutionConfigs.begin()) : kNoRow;
+    }
+
+}  // namespace gotoslnx
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "config_bits.h"
+#include "string_pool.h"
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    constexpr uint8_t kMappingActive = 1 << 0;
+    constexpr uint8_t kMappingBuild  = 1 << 1;
+    constexpr uint8_t kMappingDeploy = 1 << 2;
+
+    // 一行映射的值拷贝，字符串均为 SolutionData::strings 中的 id
+    struct ConfigMapping
+    {
+        uint32_t solutionConfig   = StringPool::kNone;
+        uint32_t projectBuildType = StringPool::kNone;
+        uint32_t projectPlatform  = StringPool::kNone;
+        uint8_t  flags            = 0;
+
+        bool Has(uint8_t flag) const { return (flags & flag) != 0; }
+    };
+
+    // 整个解决方案的项目配置映射，按列存放。
+    // 解析期间行按到达顺序追加；Seal() 后按 (项目, 解决方案配置) 排序，每个项目的行连续，可按项目二分查找。
+    // 追加时只为当前项目维护配置到行的索引，.sln 中同一项目的映射行总是连续的；
+    // 不连续地再次出现的项目会追加重复行，由 Seal() 合并。Seal() 之后追加的行在下一次 Seal() 前不参与按项目的查询。
+    // Seal() 同时为每个项目生成按解决方案配置槽位索引的 Build / Deploy 位集，只在有 ActiveCfg 的槽位上置位。
+    class ConfigMappingTable
+    {
+    public:
+        static constexpr uint32_t kNoRow = UINT32_MAX;
+
+        std::vector<uint32_t> projects;
+        std::vector<uint32_t> solutionConfigs;
+        std::vector<uint32_t> buildTypes;
+        std::vector<uint32_t> platforms;
+        std::vector<uint8_t>  flags;
+
+        size_t Size() const { return projects.size(); }
+
+        // 返回 (行号, 是否新插入)；新行的各列为 kNone / 0。已封存的行按二分查找命中
+        std::pair<uint32_t, bool> Upsert(uint32_t project, uint32_t solutionConfig);
+        void                      Seal(size_t projectCount);
+
+        uint32_t      Begin(uint32_t project) const { return m_projectOffsets[project]; }
+        uint32_t      End(uint32_t project) const { return m_projectOffsets[project + 1]; }
+        uint32_t      Find(uint32_t project, uint32_t solutionConfig) const;
+        ConfigMapping Row(uint32_t row) const { return { solutionConfigs[row], buildTypes[row], platforms[row], flags[row] }; }
+
+        // 槽位是出现过的解决方案配置 id 的稠密编号
+        size_t            SlotCount() const { return m_slotConfigs.size(); }
+        uint32_t          Slot(uint32_t solutionConfig) const;
+        const ConfigBits& ActiveBits(uint32_t project) const { return m_active[project]; }
+        const ConfigBits& BuildBits(uint32_t project) const { return m_build[project]; }
+        const ConfigBits& DeployBits(uint32_t project) const { return m_deploy[project]; }
+
+    private:
+        uint32_t                               m_currentProject = kNoRow;
+        std::unordered_map<uint32_t, uint32_t> m_currentRows;  // 当前项目在 Seal() 之后追加的行，解决方案配置 -> 行号
+        std::vector<uint32_t>                  m_projectOffsets;
+        std::vector<uint32_t>                  m_slotConfigs;
+        std::vector<ConfigBits>                m_active;
+        std::vector<ConfigBits>                m_build;
+        std::vector<ConfigBits>                m_deploy;
+    };
+
+}  // namespace gotoslnx
@@ -0,0 +1,286 @@
+#include "dependency_graph.h"
+#include "json_util.h"
+#include "sln_parser.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        constexpr uint32_t kUnvisited = std::numeric_limits<uint32_t>::max();
+
+        struct TarjanFrame
+        {
+            uint32_t node;
+            uint32_t edge;
+        };
+
+        bool HasSelfLoop(const DependencyGraph& graph, uint32_t node)
+        {
+            for (uint32_t e = graph.edgeOffsets[node]; e < graph.edgeOffsets[node + 1]; ++e) {
+                if (graph.edges[e] == node) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void FindStronglyConnectedComponents(const DependencyGraph& graph, GraphAnalysis& analysis)
+        {
+            const uint32_t nodeCount = static_cast<uint32_t>(graph.nodes.size());
+
+            std::vector<uint32_t>    index(nodeCount, kUnvisited);
+            std::vector<uint32_t>    lowLink(nodeCount, 0);
+            std::vector<bool>        onStack(nodeCount, false);
+            std::vector<uint32_t>    stack;
+            std::vector<TarjanFrame> frames;
+            uint32_t                 counter = 0;
+
+            analysis.componentOf.assign(nodeCount, kUnvisited);
+
+            auto visit = [&](uint32_t node) {
+                index[node]   = counter;
+                lowLink[node] = counter;
+                ++counter;
+                stack.push_back(node);
+                onStack[node] = true;
+                frames.push_back({ node, graph.edgeOffsets[node] });
+            };
+
+            for (uint32_t root = 0; root < nodeCount; ++root) {
+                if (index[root] != kUnvisited) {
+                    continue;
+                }
+                visit(root);
+
+                while (!frames.empty()) {
+                    uint32_t node = frames.back().node;
+                    if (frames.back().edge < graph.edgeOffsets[node + 1]) {
+                        uint32_t next = graph.edges[frames.back().edge++];
+                        if (index[next] == kUnvisited) {
+                            visit(next);
+                        } else if (onStack[next]) {
+                            lowLink[node] = std::min(lowLink[node], index[next]);
+                        }
+                        continue;
+                    }
+
+                    frames.pop_back();
+                    if (lowLink[node] == index[node]) {
+                        uint32_t              componentId = static_cast<uint32_t>(analysis.components.size());
+                        std::vector<uint32_t> component;
+                        uint32_t              member = 0;
+                        do {
+                            member = stack.back();
+                            stack.pop_back();
+                            onStack[member]              = false;
+                            analysis.componentOf[member] = componentId;
+                            component.push_back(member);
+                        } while (member != node);
+                        std::reverse(component.begin(), component.end());
+                        analysis.components.push_back(std::move(component));
+                    }
+                    if (!frames.empty()) {
+                        uint32_t parent = frames.back().node;
+                        lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+                    }
+                }
+            }
+
+            for (const auto& component : analysis.components) {
+                if (component.size() > 1 || HasSelfLoop(graph, component.front())) {
+                    analysis.cycles.push_back(component);
+                }
+            }
+        }
+
+        void ComputeLevels(const DependencyGraph& graph, GraphAnalysis& analysis)
+        {
+            const size_t          componentCount = analysis.components.size();
+            std::vector<uint32_t> componentLevel(componentCount, 0);
+            std::vector<uint32_t> componentPred(componentCount, kUnvisited);
+
+            // Tarjan 按依赖在前的顺序产出强连通分量，单遍即可求出层级
+            for (uint32_t c = 0; c < componentCount; ++c) {
+                for (uint32_t node : analysis.components[c]) {
+                    for (uint32_t e = graph.edgeOffsets[node]; e < graph.edgeOffsets[node + 1]; ++e) {
+                        uint32_t dep = analysis.componentOf[graph.edges[e]];
+                        if (dep != c && componentLevel[dep] + 1 > componentLevel[c]) {
+                            componentLevel[c] = componentLevel[dep] + 1;
+                            componentPred[c]  = dep;
+                        }
+                    }
+                }
+            }
+
+            analysis.levels.assign(graph.nodes.size(), 0);
+            for (uint32_t node = 0; node < graph.nodes.size(); ++node) {
+                uint32_t level        = componentLevel[analysis.componentOf[node]];
+                analysis.levels[node] = level;
+                if (analysis.waves.size() <= level) {
+                    analysis.waves.resize(level + 1);
+                }
+                analysis.waves[level].push_back(node);
+            }
+
+            if (componentCount == 0) {
+                return;
+            }
+            uint32_t top = static_cast<uint32_t>(
+                std::max_element(componentLevel.begin(), componentLevel.end()) - componentLevel.begin());
+            for (uint32_t c = top; c != kUnvisited; c = componentPred[c]) {
+                analysis.criticalPath.push_back(analysis.components[c].front());
+            }
+            std::reverse(analysis.criticalPath.begin(), analysis.criticalPath.end());
+        }
+
+        void AppendNodeList(std::string& out, const SolutionData& data, const DependencyGraph& graph, const std::vector<uint32_t>& nodes)
+        {
+            out.push_back('[');
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (i != 0) {
+                    out += ", ";
+                }
+                AppendJsonString(out, data.projects[graph.nodes[nodes[i]]].path);
+            }
+            out.push_back(']');
+        }
+
+        std::string FormatGraphJson(const SolutionData& data, const DependencyGraph& graph, const GraphAnalysis& analysis)
+        {
+            std::string out = "{\n  \"projects\": [\n";
+            for (uint32_t node = 0; node < graph.nodes.size(); ++node) {
+                const ProjectEntry& project = data.projects[graph.nodes[node]];
+                out += "    { \"name\": ";
+                AppendJsonString(out, project.name);
+                out += ", \"path\": ";
+                AppendJsonString(out, project.path);
+                out += ", \"id\": ";
+                AppendJsonString(out, NormalizeGuidForSlnx(project.guid));
+                out += fmt::format(", \"level\": {}, \"dependencies\": ", analysis.levels[node]);
+                std::vector<uint32_t> deps(
+                    graph.edges.begin() + graph.edgeOffsets[node], graph.edges.begin() + graph.edgeOffsets[node + 1]);
+                AppendNodeList(out, data, graph, deps);
+                out += node + 1 < graph.nodes.size() ? " },\n" : " }\n";
+            }
+            out += "  ],\n  \"levels\": [\n";
+            for (size_t level = 0; level < analysis.waves.size(); ++level) {
+                out += "    ";
+                AppendNodeList(out, data, graph, analysis.waves[level]);
+                out += level + 1 < analysis.waves.size() ? ",\n" : "\n";
+            }
+            out += fmt::format("  ],\n  \"levelCount\": {},\n  \"criticalPathLength\": {},\n  \"criticalPath\": ", analysis.waves.size(),
+                analysis.criticalPath.size());
+            AppendNodeList(out, data, graph, analysis.criticalPath);
+            out += ",\n  \"cycles\": [";
+            for (size_t i = 0; i < analysis.cycles.size(); ++i) {
+                out += i == 0 ? "\n    " : ",\n    ";
+                AppendNodeList(out, data, graph, analysis.cycles[i]);
+            }
+            out += analysis.cycles.empty() ? "],\n" : "\n  ],\n";
+            out += "  \"missingDependencies\": [";
+            for (size_t i = 0; i < graph.missingDependencies.size(); ++i) {
+                const auto& [node, guid] = graph.missingDependencies[i];
+                out += i == 0 ? "\n    { \"project\": " : ",\n    { \"project\": ";
+                AppendJsonString(out, data.projects[graph.nodes[node]].path);
+                out += ", \"dependency\": ";
+                AppendJsonString(out, guid);
+                out += " }";
+            }
+            out += graph.missingDependencies.empty() ? "]\n}\n" : "\n  ]\n}\n";
+            return out;
+        }
+
+        std::string EscapeDot(std::string_view text)
+        {
+            std::string out;
+            out.reserve(text.size());
+            for (char ch : text) {
+                if (ch == '"' || ch == '\\') {
+                    out.push_back('\\');
+                }
+                out.push_back(ch);
+            }
+            return out;
+        }
+
+        std::string FormatGraphDot(const SolutionData& data, const DependencyGraph& graph, const GraphAnalysis& analysis)
+        {
+            std::string out = "digraph Solution {\n  rankdir=BT;\n  node [shape=box];\n";
+            for (size_t level = 0; level < analysis.waves.size(); ++level) {
+                out += fmt::format("  subgraph level{} {{\n    rank=same;\n", level);
+                for (uint32_t node : analysis.waves[level]) {
+                    const ProjectEntry& project = data.projects[graph.nodes[node]];
+                    out += fmt::format("    n{} [label=\"{}\", tooltip=\"{}\"];\n", node, EscapeDot(project.name), EscapeDot(project.path));
+                }
+                out += "  }\n";
+            }
+            for (uint32_t node = 0; node < graph.nodes.size(); ++node) {
+                for (uint32_t e = graph.edgeOffsets[node]; e < graph.edgeOffsets[node + 1]; ++e) {
+                    uint32_t dep     = graph.edges[e];
+                    bool     inCycle = analysis.componentOf[dep] == analysis.componentOf[node]
+                        && (analysis.components[analysis.componentOf[node]].size() > 1 || dep == node);
+                    out += fmt::format("  n{} -> n{}{};\n", node, dep, inCycle ? " [color=red]" : "");
+                }
+            }
+            out += "}\n";
+            return out;
+        }
+
+    }  // namespace
+
+    DependencyGraph BuildDependencyGraph(const SolutionData& data)
+    {
+        DependencyGraph                           graph;
+        std::unordered_map<std::string, uint32_t> nodeByGuid;
+        for (size_t i = 0; i < data.projects.size(); ++i) {
+            if (data.projects[i].isSolutionFolder) {
+                continue;
+            }
+            nodeByGuid.emplace(NormalizeGuidForSlnx(data.projects[i].guid), static_cast<uint32_t>(graph.nodes.size()));
+            graph.nodes.push_back(i);
+        }
+
+        graph.edgeOffsets.reserve(graph.nodes.size() + 1);
+        graph.edgeOffsets.push_back(0);
+        for (uint32_t node = 0; node < graph.nodes.size(); ++node) {
+            size_t begin = graph.edges.size();
+            for (const auto& dep : data.projects[graph.nodes[node]].dependencies) {
+                auto found = nodeByGuid.find(NormalizeGuidForSlnx(dep));
+                if (found == nodeByGuid.end()) {
+                    graph.missingDependencies.emplace_back(node, dep);
+                    continue;
+                }
+                graph.edges.push_back(found->second);
+            }
+            std::sort(graph.edges.begin() + begin, graph.edges.end());
+            graph.edges.erase(std::unique(graph.edges.begin() + begin, graph.edges.end()), graph.edges.end());
+            graph.edgeOffsets.push_back(static_cast<uint32_t>(graph.edges.size()));
+        }
+        return graph;
+    }
+
+    GraphAnalysis AnalyzeDependencyGraph(const DependencyGraph& graph)
+    {
+        GraphAnalysis analysis;
+        FindStronglyConnectedComponents(graph, analysis);
+        ComputeLevels(graph, analysis);
+        return analysis;
+    }
+
+    std::string FormatGraph(const SolutionData& data, const DependencyGraph& graph, const GraphAnalysis& analysis, GraphFormat format)
+    {
+        if (format == GraphFormat::Dot) {
+            return FormatGraphDot(data, graph, analysis);
+        }
+        return FormatGraphJson(data, graph, analysis);
+    }
+
+}  // namespace gotoslnx
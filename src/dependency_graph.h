@@ -0,0 +1,43 @@
+#pragma once
+
+#include "solution.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 以非文件夹项目为节点，边从项目指向其依赖（CSR 存储）
+    struct DependencyGraph
+    {
+        std::vector<size_t>                           nodes;
+        std::vector<uint32_t>                         edgeOffsets;
+        std::vector<uint32_t>                         edges;
+        std::vector<std::pair<uint32_t, std::string>> missingDependencies;
+    };
+
+    struct GraphAnalysis
+    {
+        std::vector<uint32_t>              componentOf;
+        std::vector<std::vector<uint32_t>> components;  // 依赖在前的拓扑顺序
+        std::vector<std::vector<uint32_t>> cycles;
+        std::vector<uint32_t>              levels;
+        std::vector<std::vector<uint32_t>> waves;
+        std::vector<uint32_t>              criticalPath;
+    };
+
+    enum class GraphFormat
+    {
+        Json,
+        Dot,
+    };
+
+    DependencyGraph BuildDependencyGraph(const SolutionData& data);
+    GraphAnalysis   AnalyzeDependencyGraph(const DependencyGraph& graph);
+
+    std::string FormatGraph(const SolutionData& data, const DependencyGraph& graph, const GraphAnalysis& analysis, GraphFormat format);
+
+}  // namespace gotoslnx
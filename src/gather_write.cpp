@@ -0,0 +1,119 @@
+#include "gather_write.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <climits>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace gotoslnx
+{
+
+#ifdef _WIN32
+
+    namespace
+    {
+
+        constexpr size_t kStagingSize = 1 << 20;
+
+        void WriteAll(HANDLE file, const std::filesystem::path& path, std::string_view data)
+        {
+            while (!data.empty()) {
+                DWORD request = static_cast<DWORD>(std::min<size_t>(data.size(), 1u << 30));
+                DWORD written = 0;
+                // 没有报错却一个字节也没写出时同样视为失败，否则会原地空转
+                if (!WriteFile(file, data.data(), request, &written, nullptr) || written == 0) {
+                    CloseHandle(file);
+                    throw std::runtime_error(fmt::format("写入文件失败: {}", path.string()));
+                }
+                data.remove_prefix(written);
+            }
+        }
+
+    }  // namespace
+
+    void WriteGathered(const std::filesystem::path& path, std::span<const std::string_view> pieces)
+    {
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error(fmt::format("无法写入文件: {}", path.string()));
+        }
+        // WriteFileGather 要求页对齐的缓冲区；小段先拼进暂存区，攒满 kStagingSize 再写，不小于暂存区的段直接写出
+        std::string staging;
+        staging.reserve(kStagingSize);
+        for (std::string_view piece : pieces) {
+            if (staging.size() + piece.size() > kStagingSize) {
+                WriteAll(file, path, staging);
+                staging.clear();
+            }
+            if (piece.size() >= kStagingSize) {
+                WriteAll(file, path, piece);
+            } else {
+                staging.append(piece);
+            }
+        }
+        WriteAll(file, path, staging);
+        if (!CloseHandle(file)) {
+            throw std::runtime_error(fmt::format("写入文件失败: {}", path.string()));
+        }
+    }
+
+#else
+
+    void WriteGathered(const std::filesystem::path& path, std::span<const std::string_view> pieces)
+    {
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (fd < 0) {
+            throw std::runtime_error(fmt::format("无法写入文件: {}", path.string()));
+        }
+        std::vector<iovec> vectors;
+        vectors.reserve(pieces.size());
+        for (std::string_view piece : pieces) {
+            if (!piece.empty()) {
+                vectors.push_back({ const_cast<char*>(piece.data()), piece.size() });
+            }
+        }
+        // 每次最多提交 IOV_MAX 段；部分写入时跳过已写完的段，并截掉当前段已写出的前缀
+        size_t next = 0;
+        while (next < vectors.size()) {
+            int     count   = static_cast<int>(std::min<size_t>(vectors.size() - next, IOV_MAX));
+            ssize_t written = writev(fd, vectors.data() + next, count);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                close(fd);
+                throw std::runtime_error(fmt::format("写入文件失败: {}", path.string()));
+            }
+            auto remaining = static_cast<size_t>(written);
+            while (next < vectors.size() && remaining >= vectors[next].iov_len) {
+                remaining -= vectors[next].iov_len;
+                ++next;
+            }
+            if (remaining != 0) {
+                vectors[next].iov_base = static_cast<char*>(vectors[next].iov_base) + remaining;
+                vectors[next].iov_len -= remaining;
+            }
+        }
+        if (close(fd) != 0) {
+            throw std::runtime_error(fmt::format("写入文件失败: {}", path.string()));
+        }
+    }
+
+#endif
+
+}  // namespace gotoslnx
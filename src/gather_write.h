@@ -0,0 +1,14 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace gotoslnx
+{
+
+    // 按顺序把各段写入文件（覆盖已有内容），各段不必先拼接成一整块。
+    // POSIX 上用 writev 一次提交多段，Windows 上把小段拼成 1 MiB 的块再写，失败时抛出 std::runtime_error
+    void WriteGathered(const std::filesystem::path& path, std::span<const std::string_view> pieces);
+
+}  // namespace gotoslnx
@@ -0,0 +1,214 @@
+#include "guid_util.h"
+
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+
+#include <fmt/format.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GOTOSLNX_GUID_SSE2 1
+#endif
+
+namespace gotoslnx
+{
+
+    std::string FormatGuidForSln(std::string_view guid)
+    {
+        std::string output;
+        output.reserve(guid.size() + 2);
+        output.push_back('{');
+        for (unsigned char ch : guid) {
+            if (ch == '{' || ch == '}') {
+                continue;
+            }
+            output.push_back(static_cast<char>(std::toupper(ch)));
+        }
+        output.push_back('}');
+        return output;
+    }
+
+    std::string MakeDeterministicGuid(std::string_view seed)
+    {
+        uint64_t high = 0xcbf29ce484222325ULL;
+        uint64_t low  = 0x84222325cbf29ce4ULL;
+        for (unsigned char ch : seed) {
+            high = (high ^ std::tolower(ch)) * 0x100000001b3ULL;
+            low  = (low ^ std::tolower(ch)) * 0x100000001b3ULL;
+            low ^= low >> 29;
+        }
+        // 标记为 RFC 4122 第 5 版、变体 1，避免与真实随机 GUID 的格式混淆
+        high = (high & ~0xF000ULL) | 0x5000ULL;
+        low  = (low & ~(0xC0ULL << 56)) | (0x80ULL << 56);
+        return fmt::format("{{{:08X}-{:04X}-{:04X}-{:04X}-{:012X}}}", high >> 32, (high >> 16) & 0xFFFF, high & 0xFFFF, low >> 48,
+            low & 0xFFFFFFFFFFFFULL);
+    }
+
+    bool IsGuidText(std::string_view text)
+    {
+        if (text.size() == 38 && text.front() == '{' && text.back() == '}') {
+            text = text.substr(1, 36);
+        }
+        if (text.size() != 36) {
+            return false;
+        }
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (i == 8 || i == 13 || i == 18 || i == 23) {
+                if (text[i] != '-') {
+                    return false;
+                }
+            } else if (!std::isxdigit(static_cast<unsigned char>(text[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    namespace
+    {
+
+        // 带花括号形式中 16 个字节各自高位十六进制字符的下标，低位紧随其后
+        constexpr uint8_t kBracedByteOffsets[16] = { 1, 3, 5, 7, 10, 12, 15, 17, 20, 22, 25, 27, 29, 31, 33, 35 };
+
+        constexpr bool IsBracedGuidLiteral(size_t index)
+        {
+            return index == 0 || index == 9 || index == 14 || index == 19 || index == 24 || index == 37;
+        }
+
+        constexpr char BracedGuidLiteral(size_t index)
+        {
+            return index == 0 ? '{' : index == 37 ? '}' : '-';
+        }
+
+#if defined(GOTOSLNX_GUID_SSE2)
+        // 三段 16 字节的加载起点，最后一段与第二段重叠，恰好止于右花括号
+        constexpr size_t kChunkStarts[3] = { 0, 16, 22 };
+
+        // 按文本下标排列：该位置应为 { - } 时 kLiteralMask 为 0xFF，kLiterals 为应有的字符
+        constexpr auto kLiteralMask = [] {
+            std::array<uint8_t, kBracedGuidLength> mask{};
+            for (size_t i = 0; i < mask.size(); ++i) {
+                mask[i] = IsBracedGuidLiteral(i) ? 0xFF : 0;
+            }
+            return mask;
+        }();
+        constexpr auto kLiterals = [] {
+            std::array<uint8_t, kBracedGuidLength> literals{};
+            for (size_t i = 0; i < literals.size(); ++i) {
+                literals[i] = IsBracedGuidLiteral(i) ? static_cast<uint8_t>(BracedGuidLiteral(i)) : 0;
+            }
+            return literals;
+        }();
+
+        __m128i Load(const void* data)
+        {
+            return _mm_loadu_si128(static_cast<const __m128i*>(data));
+        }
+
+        // 无符号比较 lo <= value <= lo + span
+        __m128i InRange(__m128i value, char lo, uint8_t span)
+        {
+            __m128i offset = _mm_sub_epi8(value, _mm_set1_epi8(lo));
+            return _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(static_cast<char>(span))), offset);
+        }
+
+        // 校验从 start 起的 16 个字符，并把各字符的半字节值写入 nibbles 的同一下标；格式不对时返回 false
+        bool DecodeChunk(const char* text, size_t start, uint8_t* nibbles)
+        {
+            __m128i chunk       = Load(text + start);
+            __m128i literalMask = Load(kLiteralMask.data() + start);
+            __m128i lower       = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+            __m128i isDigit     = InRange(chunk, '0', 9);
+            __m128i isHex       = _mm_or_si128(isDigit, InRange(lower, 'a', 5));
+            __m128i literal     = _mm_and_si128(_mm_cmpeq_epi8(chunk, Load(kLiterals.data() + start)), literalMask);
+            __m128i valid       = _mm_or_si128(_mm_andnot_si128(literalMask, isHex), literal);
+            if (_mm_movemask_epi8(valid) != 0xFFFF) {
+                return false;
+            }
+            __m128i digitValue = _mm_and_si128(isDigit, _mm_sub_epi8(chunk, _mm_set1_epi8('0')));
+            __m128i alphaValue = _mm_andnot_si128(isDigit, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(nibbles + start), _mm_or_si128(digitValue, alphaValue));
+            return true;
+        }
+#else
+        // 十六进制字符的值，其余字符为 0xFF
+        constexpr auto kHexValues = [] {
+            std::array<uint8_t, 256> table{};
+            table.fill(0xFF);
+            for (int i = 0; i < 10; ++i) {
+                table['0' + i] = static_cast<uint8_t>(i);
+            }
+            for (int i = 0; i < 6; ++i) {
+                table['a' + i] = static_cast<uint8_t>(10 + i);
+                table['A' + i] = static_cast<uint8_t>(10 + i);
+            }
+            return table;
+        }();
+
+        constexpr char kLowerHexDigits[] = "0123456789abcdef";
+#endif
+
+    }  // namespace
+
+    bool DecodeBracedGuid(std::string_view text, GuidBytes& guid)
+    {
+        if (text.size() != kBracedGuidLength) {
+            return false;
+        }
+        uint8_t nibbles[kBracedGuidLength];
+#if defined(GOTOSLNX_GUID_SSE2)
+        for (size_t start : kChunkStarts) {
+            if (!DecodeChunk(text.data(), start, nibbles)) {
+                return false;
+            }
+        }
+#else
+        for (size_t i = 0; i < kBracedGuidLength; ++i) {
+            if (IsBracedGuidLiteral(i)) {
+                if (text[i] != BracedGuidLiteral(i)) {
+                    return false;
+                }
+            } else if ((nibbles[i] = kHexValues[static_cast<unsigned char>(text[i])]) == 0xFF) {
+                return false;
+            }
+        }
+#endif
+        for (size_t i = 0; i < guid.size(); ++i) {
+            guid[i] = static_cast<uint8_t>(nibbles[kBracedByteOffsets[i]] << 4 | nibbles[kBracedByteOffsets[i] + 1]);
+        }
+        return true;
+    }
+
+    void EncodeGuidLower(const GuidBytes& guid, char* out)
+    {
+        char hex[32];
+#if defined(GOTOSLNX_GUID_SSE2)
+        __m128i bytes = Load(guid.data());
+        __m128i low   = _mm_and_si128(bytes, _mm_set1_epi8(0x0F));
+        __m128i high  = _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0F));
+        for (int half = 0; half < 2; ++half) {
+            // 高低半字节交错后，大于 9 的再跳过 ':' 到 '`' 之间的 39 个字符
+            __m128i nibbles = half == 0 ? _mm_unpacklo_epi8(high, low) : _mm_unpackhi_epi8(high, low);
+            __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8(39));
+            __m128i digits  = _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(hex + half * 16), digits);
+        }
+#else
+        for (size_t i = 0; i < guid.size(); ++i) {
+            hex[i * 2]     = kLowerHexDigits[guid[i] >> 4];
+            hex[i * 2 + 1] = kLowerHexDigits[guid[i] & 0x0F];
+        }
+#endif
+        std::memcpy(out, hex, 8);
+        out[8] = '-';
+        std::memcpy(out + 9, hex + 8, 4);
+        out[13] = '-';
+        std::memcpy(out + 14, hex + 12, 4);
+        out[18] = '-';
+        std::memcpy(out + 19, hex + 16, 4);
+        out[23] = '-';
+        std::memcpy(out + 24, hex + 20, 12);
+    }
+
+}  // namespace gotoslnx
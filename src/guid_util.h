@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace gotoslnx
+{
+
+    // slnx 形式（小写、无花括号）转换为 .sln 形式（大写、带花括号）
+    std::string FormatGuidForSln(std::string_view guid);
+
+    // 由任意文本稳定地派生 GUID，用于 .slnx 中省略了 Id 的项目与文件夹
+    std::string MakeDeterministicGuid(std::string_view seed);
+
+    bool IsGuidText(std::string_view text);
+
+    // 按文本顺序排列的 16 字节（不是 Windows GUID 结构的混合字节序），用于在两种文本形式之间转换，
+    // 也用作不区分大小写的查找键
+    using GuidBytes = std::array<uint8_t, 16>;
+
+    struct GuidBytesHash
+    {
+        size_t operator()(const GuidBytes& guid) const
+        {
+            uint64_t low  = 0;
+            uint64_t high = 0;
+            std::memcpy(&low, guid.data(), sizeof(low));
+            std::memcpy(&high, guid.data() + sizeof(low), sizeof(high));
+            return static_cast<size_t>((low ^ high) * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    constexpr size_t kBracedGuidLength = 38;
+    constexpr size_t kSlnxGuidLength   = 36;
+
+    // 校验并解码 {xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}，大小写均可；格式不对时返回 false。
+    // x86-64 上以 SSE2 一次校验 16 个字符，其余平台逐字符查表
+    bool DecodeBracedGuid(std::string_view text, GuidBytes& guid);
+
+    // 写出 slnx 的小写无花括号形式，out 须有 kSlnxGuidLength 个字符的空间
+    void EncodeGuidLower(const GuidBytes& guid, char* out);
+
+}  // namespace gotoslnx
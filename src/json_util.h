@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+namespace gotoslnx
+{
+
+    inline void AppendJsonString(std::string& out, std::string_view text)
+    {
+        out.push_back('"');
+        for (char ch : text) {
+            switch (ch) {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(ch) < 0x20) {
+                        out += fmt::format("\\u{:04x}", static_cast<unsigned>(ch));
+                    } else {
+                        out.push_back(ch);
+                    }
+                    break;
+            }
+        }
+        out.push_back('"');
+    }
+
+}  // namespace gotoslnx
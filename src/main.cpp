@@ -1,483 +1,526 @@
-#include <cctype>
+#include "archive_convert.h"
+#include "batch_convert.h"
+#include "dependency_graph.h"
+#include "path_rebase.h"
+#include "sln_parser.h"
+#include "sln_writer.h"
+#include "slnx_reader.h"
+#include "slnx_writer.h"
+#include "solution_diff.h"
+#include "solution_filter.h"
+#include "solution_items.h"
+#include "solution_merge.h"
+#include "solution_snapshot.h"
+#include "trace.h"
+#include "work_stealing.h"
+
 #include <filesystem>
 #include <fstream>
-#include <map>
+#include <functional>
 #include <optional>
-#include <regex>
-#include <set>
+#include <stdexcept>
 #include <string>
-#include <string_view>
 #include <unordered_map>
-#include <utility>
 #include <vector>
 
 #include <cxxopts.hpp>
 #include <fmt/format.h>
-#include <tinyxml2.h>
 
 namespace fs = std::filesystem;
+using namespace gotoslnx;
 
 namespace
 {
 
-    constexpr std::string_view kSolutionFolderTypeGuid = "{66A26720-8FB5-11D2-AA7E-00C04F688DDE}";
-
-    struct ProjectConfigMapping
-    {
-        std::string projectBuildType;
-        std::string projectPlatform;
-        bool        hasActive = false;
-        bool        build     = false;
-        bool        buildSet  = false;
-        bool        deploy    = false;
-        bool        deploySet = false;
-    };
-
-    struct ProjectEntry
-    {
-        std::string                                 typeGuid;
-        std::string                                 name;
-        std::string                                 path;
-        std::string                                 guid;
-        std::vector<std::string>                    dependencies;
-        std::vector<std::string>                    solutionItems;
-        std::map<std::string, ProjectConfigMapping> configMap;
-        bool                                        isSolutionFolder = false;
-    };
+    constexpr size_t kProjectsPerWriteTask = 256;
 
-    struct SolutionData
+    fs::path ResolveInputPath(const std::string& input, const std::string& extension)
     {
-        std::vector<ProjectEntry>                    projects;
-        std::unordered_map<std::string, std::string> guidToPath;
-        std::unordered_map<std::string, std::string> guidToName;
-        std::unordered_map<std::string, std::string> nestedProjects;
-        std::set<std::string>                        solutionConfigs;
-        std::set<std::string>                        buildTypes;
-        std::set<std::string>                        platforms;
-    };
+        TraceSpan span("ResolveInputPath", input);
+        fs::path path(input);
+        if (fs::is_directory(path)) {
+            std::vector<fs::path> slnFiles;
+            for (const auto& entry : fs::directory_iterator(path)) {
+                if (entry.path().extension() == extension) {
+                    slnFiles.push_back(entry.path());
+                }
+            }
+            if (slnFiles.empty()) {
+                throw std::runtime_error(fmt::format("目录中未找到 {0} 文件。请指定具体的 {0} 文件路径。", extension));
+            }
+            if (slnFiles.size() > 1) {
+                throw std::runtime_error(fmt::format("目录中存在多个 {} 文件，请指定要转换的文件。", extension));
+            }
+            return slnFiles.front();
+        }
+        return path;
+    }
 
-    std::string Trim(std::string_view input)
+    fs::path OutputPathFor(const cxxopts::ParseResult& result, const fs::path& inputPath, const std::string& extension)
     {
-        size_t start = 0;
-        while (start < input.size() && std::isspace(static_cast<unsigned char>(input[start]))) {
-            ++start;
-        }
-        size_t end = input.size();
-        while (end > start && std::isspace(static_cast<unsigned char>(input[end - 1]))) {
-            --end;
+        fs::path outputPath;
+        if (result.count("output")) {
+            outputPath = result["output"].as<std::string>();
+        } else {
+            outputPath = inputPath;
+            outputPath.replace_extension(extension);
         }
-        return std::string(input.substr(start, end - start));
+        return outputPath;
     }
 
-    bool StartsWith(std::string_view text, std::string_view prefix)
+    fs::path ResolveOutputPath(const cxxopts::ParseResult& result, const fs::path& inputPath, const std::string& extension)
     {
-        return text.size() >= prefix.size() && text.substr(0, prefix.size()) == prefix;
+        fs::path outputPath = OutputPathFor(result, inputPath, extension);
+        if (fs::exists(outputPath) && !result["force"].as<bool>()) {
+            throw std::runtime_error(fmt::format("输出 {} 已存在，使用 --force 覆盖。", extension));
+        }
+        return outputPath;
     }
 
-    std::vector<std::string> SplitOnce(std::string_view text, char delimiter)
+    void WriteTextFile(const fs::path& path, const std::string& content)
     {
-        auto pos = text.find(delimiter);
-        if (pos == std::string_view::npos) {
-            return { std::string(text) };
+        std::string pathText = path.string();
+        TraceSpan   span("write", pathText);
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            throw std::runtime_error(fmt::format("无法写入文件: {}", path.string()));
+        }
+        output.write(content.data(), static_cast<std::streamsize>(content.size()));
+        if (!output) {
+            throw std::runtime_error(fmt::format("写入文件失败: {}", path.string()));
         }
-        return { std::string(text.substr(0, pos)), std::string(text.substr(pos + 1)) };
     }
 
-    std::pair<std::string, std::string> SplitConfig(const std::string& config)
+    GraphFormat ResolveGraphFormat(const cxxopts::ParseResult& result, const fs::path& graphPath)
     {
-        auto parts = SplitOnce(config, '|');
-        if (parts.size() == 1) {
-            return { Trim(parts[0]), std::string() };
+        std::string format;
+        if (result.count("graph-format")) {
+            format = result["graph-format"].as<std::string>();
+        } else {
+            format = graphPath.extension() == ".dot" || graphPath.extension() == ".gv" ? "dot" : "json";
         }
-        return { Trim(parts[0]), Trim(parts[1]) };
+        if (format == "json") {
+            return GraphFormat::Json;
+        }
+        if (format == "dot") {
+            return GraphFormat::Dot;
+        }
+        throw std::runtime_error(fmt::format("未知的依赖图格式: {}（可选 json、dot）", format));
     }
 
-    std::optional<ProjectEntry> ParseProjectHeader(const std::string& line)
+    std::optional<MissingItemPolicy> ResolveMissingItemPolicy(const cxxopts::ParseResult& result)
     {
-        static const std::regex pattern(R"SLN(^Project\("\{([^}]+)\}"\)\s*=\s*"([^"]+)",\s*"([^"]+)",\s*"\{([^}]+)\}"\s*$)SLN");
-        std::smatch             match;
-        if (!std::regex_match(line, match, pattern)) {
+        if (!result.count("check-items")) {
             return std::nullopt;
         }
-        ProjectEntry entry;
-        entry.typeGuid         = fmt::format("{{{}}}", match[1].str());
-        entry.name             = match[2].str();
-        entry.path             = match[3].str();
-        entry.guid             = fmt::format("{{{}}}", match[4].str());
-        entry.isSolutionFolder = fmt::format("{{{}}}", match[1].str()) == kSolutionFolderTypeGuid;
-        return entry;
+        std::string policy = result["check-items"].as<std::string>();
+        if (policy == "warn") {
+            return MissingItemPolicy::Warn;
+        }
+        if (policy == "drop") {
+            return MissingItemPolicy::Drop;
+        }
+        throw std::runtime_error(fmt::format("未知的解决方案项检查方式: {}（可选 warn、drop）", policy));
     }
 
-    void ParseSolutionConfiguration(const std::string& line, SolutionData& data)
+    // 输入是快照时由快照复制出完整数据（不解析文本）；指定 --snapshot 时复用或刷新 .sln 旁的快照
+    SolutionData LoadSolution(const fs::path& inputPath, const cxxopts::ParseResult& result)
     {
-        auto parts = SplitOnce(line, '=');
-        if (parts.empty()) {
-            return;
-        }
-        std::string left = Trim(parts[0]);
-        if (left.empty()) {
-            return;
+        if (inputPath.extension() == kSnapshotExtension) {
+            return SolutionSnapshot(inputPath).ToSolutionData();
         }
-        data.solutionConfigs.insert(left);
-        auto configParts = SplitConfig(left);
-        if (!configParts.first.empty()) {
-            data.buildTypes.insert(configParts.first);
+        if (!result["snapshot"].as<bool>()) {
+            return ParseSln(inputPath);
         }
-        if (!configParts.second.empty()) {
-            data.platforms.insert(configParts.second);
+        std::string  warning;
+        SolutionData data = ParseSlnWithSnapshot(inputPath, warning);
+        if (!warning.empty()) {
+            fmt::print(stderr, "警告: {}\n", warning);
         }
+        return data;
     }
 
-    void ParseProjectConfiguration(const std::string& line, SolutionData& data)
+    // 项目较多时另起调度器，按项目区间并行计算配置规则和渲染项目元素
+    void WriteSlnxFile(const fs::path& outputPath, const SolutionData& data, const cxxopts::ParseResult& result)
     {
-        auto parts = SplitOnce(line, '=');
-        if (parts.size() < 2) {
-            return;
-        }
-        std::string left  = Trim(parts[0]);
-        std::string right = Trim(parts[1]);
+        SlnxWriteOptions             writeOptions;
+        std::optional<TaskScheduler> scheduler;
+        writeOptions.canonical = result["canonical"].as<bool>();
+        if (data.projects.size() > kProjectsPerWriteTask) {
+            scheduler.emplace(result["jobs"].as<size_t>());
+            writeOptions.runRanges = [&scheduler](size_t count, const std::function<void(size_t, size_t)>& fn) {
+                scheduler->ParallelFor(count, kProjectsPerWriteTask, fn);
+            };
+        }
+        WriteSlnx(outputPath, data, writeOptions);
+    }
 
-        if (!StartsWith(left, "{")) {
-            return;
+    // --fix-path-case 与 --check-items 共用一个调度器和目录索引，合并时多个解决方案也只列举一次目录
+    class PathChecks
+    {
+    public:
+        explicit PathChecks(const cxxopts::ParseResult& result)
+            : m_fixCase(result["fix-path-case"].as<bool>())
+            , m_policy(ResolveMissingItemPolicy(result))
+        {
+            if (m_fixCase || m_policy) {
+                m_scheduler.emplace(result["jobs"].as<size_t>());
+            }
         }
 
-        auto guidEnd = left.find('}');
-        if (guidEnd == std::string::npos) {
-            return;
-        }
-        std::string guid      = left.substr(0, guidEnd + 1);
-        std::string remainder = left.substr(guidEnd + 1);
-        if (remainder.empty() || remainder[0] != '.') {
-            return;
+        void FixCase(SolutionData& data, const fs::path& baseDir)
+        {
+            if (m_fixCase) {
+                if (size_t fixed = FixPathCase(data, baseDir, m_cache, *m_scheduler); fixed != 0) {
+                    fmt::print("已按磁盘上的大小写修正 {} 个路径\n", fixed);
+                }
+            }
         }
-        remainder = remainder.substr(1);
 
-        auto lastDot = remainder.rfind('.');
-        if (lastDot == std::string::npos) {
-            return;
+        void CheckItems(SolutionData& data, const fs::path& baseDir)
+        {
+            if (m_policy) {
+                for (const auto& missing : CheckSolutionItems(data, baseDir, *m_policy, m_cache, *m_scheduler)) {
+                    fmt::print(stderr, "警告: {}\n", DescribeMissingItem(data, missing, *m_policy));
+                }
+            }
         }
-        std::string solutionConfig = remainder.substr(0, lastDot);
-        std::string suffix         = remainder.substr(lastDot + 1);
 
-        data.solutionConfigs.insert(solutionConfig);
+    private:
+        bool                             m_fixCase;
+        std::optional<MissingItemPolicy> m_policy;
+        std::optional<TaskScheduler>     m_scheduler;
+        DirectoryListingCache            m_cache;
+    };
 
-        auto projectIter
-            = std::find_if(data.projects.begin(), data.projects.end(), [&](const ProjectEntry& entry) { return entry.guid == guid; });
-        if (projectIter == data.projects.end()) {
-            return;
-        }
+    bool VerifyConversion(const fs::path& slnPath, const fs::path& slnxPath, const SolutionData& source)
+    {
+        SolutionData converted = ReadSlnx(slnxPath);
+        SolutionDiff diff      = CompareSolutions(source, converted);
+        if (diff.Empty()) {
+            fmt::print("验证通过: {} 个项目、{} 个文件夹一致\n", diff.comparedProjects, diff.comparedFolders);
+            return true;
+        }
+        fmt::print("验证失败: {} 与 {} 存在 {} 处差异\n{}", slnPath.string(), slnxPath.string(), diff.entries.size(),
+            FormatSolutionDiff(diff));
+        return false;
+    }
 
-        ProjectConfigMapping& mapping = projectIter->configMap[solutionConfig];
-        if (suffix == "ActiveCfg") {
-            auto configParts         = SplitConfig(right);
-            mapping.projectBuildType = configParts.first;
-            mapping.projectPlatform  = configParts.second;
-            mapping.hasActive        = true;
-        } else if (StartsWith(suffix, "Build")) {
-            mapping.build    = true;
-            mapping.buildSet = true;
-            if (!right.empty() && !mapping.hasActive) {
-                auto configParts         = SplitConfig(right);
-                mapping.projectBuildType = configParts.first;
-                mapping.projectPlatform  = configParts.second;
-                mapping.hasActive        = true;
+    std::vector<FilterQuery> CollectFilterQueries(const cxxopts::ParseResult& result)
+    {
+        std::vector<FilterQuery> queries;
+        if (result.count("filter-folder")) {
+            for (const auto& folder : result["filter-folder"].as<std::vector<std::string>>()) {
+                queries.push_back({ FilterQuery::Kind::Folder, folder });
             }
-        } else if (StartsWith(suffix, "Deploy")) {
-            mapping.deploy    = true;
-            mapping.deploySet = true;
-            if (!right.empty() && !mapping.hasActive) {
-                auto configParts         = SplitConfig(right);
-                mapping.projectBuildType = configParts.first;
-                mapping.projectPlatform  = configParts.second;
-                mapping.hasActive        = true;
+        }
+        if (result.count("filter-project")) {
+            for (const auto& project : result["filter-project"].as<std::vector<std::string>>()) {
+                queries.push_back({ FilterQuery::Kind::Project, project });
             }
         }
+        return queries;
     }
 
-    void ParseNestedProject(const std::string& line, SolutionData& data)
+    void WriteSolutionFilters(const fs::path& slnxPath, const SolutionData& data, const std::vector<FilterQuery>& queries)
     {
-        auto parts = SplitOnce(line, '=');
-        if (parts.size() < 2) {
-            return;
-        }
-        std::string child  = Trim(parts[0]);
-        std::string parent = Trim(parts[1]);
-        if (child.empty() || parent.empty()) {
-            return;
+        for (const auto& filter : BuildSolutionFilters(data, queries)) {
+            fs::path filterPath = slnxPath;
+            filterPath.replace_filename(fmt::format("{}.{}.slnf", slnxPath.stem().string(), filter.name));
+            WriteTextFile(filterPath, FormatSlnf(slnxPath.filename().string(), data, filter));
+            fmt::print("已生成: {}（{} 个项目）\n", filterPath.string(), filter.projects.size());
         }
-        data.nestedProjects[child] = parent;
     }
 
-    std::string NormalizeFolderPath(const std::vector<std::string>& segments)
+    void RunSlnxToSln(const cxxopts::ParseResult& result)
     {
-        std::string path = "/";
-        for (const auto& segment : segments) {
-            if (!segment.empty()) {
-                path += segment;
-                if (path.back() != '/') {
-                    path += '/';
-                }
-            }
+        fs::path inputPath = ResolveInputPath(result["input"].as<std::string>(), ".slnx");
+        if (inputPath.extension() != ".slnx") {
+            throw std::runtime_error("输入文件不是 .slnx。");
         }
-        return path;
+        fs::path outputPath = ResolveOutputPath(result, inputPath, ".sln");
+
+        SolutionData data = ReadSlnx(inputPath);
+        RebaseSolutionPaths(data, inputPath.parent_path(), outputPath.parent_path());
+        WriteSln(outputPath, data);
+
+        fmt::print("已生成: {}\n", outputPath.string());
     }
 
-    std::string ResolveFolderPath(const std::string& folderGuid, const SolutionData& data,
-        std::unordered_map<std::string, std::string>& cache, std::unordered_map<std::string, bool>& visiting)
+    void RunMerge(const cxxopts::ParseResult& result)
     {
-        auto cached = cache.find(folderGuid);
-        if (cached != cache.end()) {
-            return cached->second;
-        }
-        if (visiting[folderGuid]) {
-            return "/";
-        }
-        visiting[folderGuid] = true;
-
-        std::vector<std::string> segments;
-        auto                     nameIter = data.guidToName.find(folderGuid);
-        if (nameIter != data.guidToName.end()) {
-            segments.push_back(nameIter->second);
-        }
-        auto parentIter = data.nestedProjects.find(folderGuid);
-        if (parentIter != data.nestedProjects.end()) {
-            std::string parentPath = ResolveFolderPath(parentIter->second, data, cache, visiting);
-            if (parentPath != "/") {
-                std::string trimmed = parentPath.substr(1);
-                if (!trimmed.empty() && trimmed.back() == '/') {
-                    trimmed.pop_back();
-                }
-                if (!trimmed.empty()) {
-                    std::vector<std::string> parentSegments;
-                    size_t                   start = 0;
-                    while (start < trimmed.size()) {
-                        auto slash = trimmed.find('/', start);
-                        if (slash == std::string::npos) {
-                            parentSegments.push_back(trimmed.substr(start));
-                            break;
-                        }
-                        parentSegments.push_back(trimmed.substr(start, slash - start));
-                        start = slash + 1;
-                    }
-                    parentSegments.insert(parentSegments.end(), segments.begin(), segments.end());
-                    segments = std::move(parentSegments);
-                }
-            } else if (segments.empty() && nameIter != data.guidToName.end()) {
-                segments.push_back(nameIter->second);
+        if (!result.count("inputs") || result["inputs"].as<std::vector<std::string>>().size() < 2) {
+            throw std::runtime_error("合并模式至少需要两个 .sln 输入。");
+        }
+        if (!result.count("output")) {
+            throw std::runtime_error("合并模式需要通过 --output 指定输出 .slnx。");
+        }
+        fs::path outputPath = result["output"].as<std::string>();
+        if (fs::exists(outputPath) && !result["force"].as<bool>()) {
+            throw std::runtime_error("输出 .slnx 已存在，使用 --force 覆盖。");
+        }
+
+        std::vector<fs::path> inputs;
+        for (const auto& input : result["inputs"].as<std::vector<std::string>>()) {
+            inputs.push_back(ResolveInputPath(input, ".sln"));
+            if (inputs.back().extension() != ".sln") {
+                throw std::runtime_error(fmt::format("输入文件不是 .sln: {}", input));
             }
         }
 
-        std::string path     = NormalizeFolderPath(segments);
-        cache[folderGuid]    = path;
-        visiting[folderGuid] = false;
-        return path;
+        PathChecks                checks(result);
+        std::vector<SolutionData> solutions = ParseSlnParallel(inputs);
+        for (size_t input = 0; input < inputs.size(); ++input) {
+            checks.FixCase(solutions[input], inputs[input].parent_path());
+        }
+        MergeResult merged = MergeSolutions(inputs, solutions, fs::absolute(outputPath).parent_path());
+        checks.CheckItems(merged.data, fs::absolute(outputPath).parent_path());
+        for (const auto& collision : merged.collisions) {
+            fmt::print(stderr, "警告: GUID 冲突 {}：{} 与 {}（来自 {}）路径不同，后者改用 {}\n", collision.guid, collision.keptPath,
+                collision.conflictingPath, collision.source.string(), collision.reassignedGuid);
+        }
+
+        WriteSlnxFile(outputPath, merged.data, result);
+        fmt::print("合并 {} 个解决方案：项目 {} 个，重复项目 {} 个，GUID 冲突 {} 处\n", inputs.size(), merged.mergedProjects,
+            merged.duplicateProjects, merged.collisions.size());
+        fmt::print("已生成: {}\n", outputPath.string());
     }
 
-    std::string NormalizeGuidForSlnx(std::string_view guid)
+    struct BatchCounts
     {
-        std::string output;
-        output.reserve(guid.size());
-        for (unsigned char ch : guid) {
-            if (ch == '{' || ch == '}') {
-                continue;
+        size_t converted = 0;
+        size_t skipped   = 0;
+        size_t failed    = 0;
+    };
+
+    BatchCounts ReportBatchItems(const std::vector<BatchItem>& items)
+    {
+        BatchCounts counts;
+        for (const auto& item : items) {
+            switch (item.status) {
+                case BatchItem::Status::Converted:
+                    ++counts.converted;
+                    for (const auto& warning : item.warnings) {
+                        fmt::print(stderr, "警告: {}: {}\n", item.input.string(), warning);
+                    }
+                    fmt::print("已生成: {}\n", item.output.string());
+                    break;
+                case BatchItem::Status::Skipped:
+                    ++counts.skipped;
+                    fmt::print("跳过: {}（输出已存在，使用 --force 覆盖）\n", item.output.string());
+                    break;
+                case BatchItem::Status::Failed:
+                    ++counts.failed;
+                    fmt::print(stderr, "错误: {}: {}\n", item.input.string(), item.error);
+                    break;
             }
-            output.push_back(static_cast<char>(std::tolower(ch)));
         }
-        return output;
+        return counts;
     }
 
-    fs::path ResolveInputPath(const std::string& input)
+    int RunBatch(const cxxopts::ParseResult& result)
     {
-        fs::path path(input);
-        if (fs::is_directory(path)) {
-            std::vector<fs::path> slnFiles;
-            for (const auto& entry : fs::directory_iterator(path)) {
-                if (entry.path().extension() == ".sln") {
-                    slnFiles.push_back(entry.path());
-                }
-            }
-            if (slnFiles.empty()) {
-                throw std::runtime_error("目录中未找到 .sln 文件。请指定具体的 .sln 文件路径。");
+        fs::path              root   = result["batch"].as<std::string>();
+        std::vector<fs::path> inputs = FindSolutionFiles(root);
+        if (inputs.empty()) {
+            throw std::runtime_error("目录中未找到 .sln 文件。");
+        }
+
+        fs::path               historyPath = root / kBatchHistoryFile;
+        BatchHistory           history     = LoadBatchHistory(historyPath);
+        TaskScheduler          scheduler(result["jobs"].as<size_t>());
+        BatchOptions           options;
+        options.force       = result["force"].as<bool>();
+        options.canonical   = result["canonical"].as<bool>();
+        options.snapshot    = result["snapshot"].as<bool>();
+        options.fixPathCase = result["fix-path-case"].as<bool>();
+        options.checkItems  = ResolveMissingItemPolicy(result);
+        std::vector<BatchItem> items = ConvertBatch(root, inputs, options, history, scheduler);
+        try {
+            SaveBatchHistory(historyPath, history);
+        } catch (const std::exception& ex) {
+            fmt::print(stderr, "警告: {}\n", ex.what());
+        }
+
+        BatchCounts counts = ReportBatchItems(items);
+        fmt::print("批量转换 {} 个解决方案：成功 {} 个，跳过 {} 个，失败 {} 个\n", items.size(), counts.converted, counts.skipped,
+            counts.failed);
+        return counts.failed == 0 ? 0 : 1;
+    }
+
+    int RunArchive(const cxxopts::ParseResult& result)
+    {
+        if (!result.count("output")) {
+            throw std::runtime_error("归档模式需要通过 --output 指定输出归档（.tar、.tar.gz 或 .tgz）。");
+        }
+        if (result["snapshot"].as<bool>() || result["fix-path-case"].as<bool>() || result.count("check-items")) {
+            throw std::runtime_error("归档模式不支持 --snapshot、--fix-path-case 与 --check-items：归档成员不在磁盘上。");
+        }
+        fs::path inputPath  = result["archive"].as<std::string>();
+        fs::path outputPath = result["output"].as<std::string>();
+        if (fs::exists(outputPath)) {
+            if (fs::exists(inputPath) && fs::equivalent(inputPath, outputPath)) {
+                throw std::runtime_error("输出归档不能与输入归档相同。");
             }
-            if (slnFiles.size() > 1) {
-                throw std::runtime_error("目录中存在多个 .sln 文件，请指定要转换的文件。");
+            if (!result["force"].as<bool>()) {
+                throw std::runtime_error("输出归档已存在，使用 --force 覆盖。");
             }
-            return slnFiles.front();
         }
-        return path;
+
+        TaskScheduler scheduler(result["jobs"].as<size_t>());
+        BatchOptions  options;
+        options.canonical            = result["canonical"].as<bool>();
+        std::vector<BatchItem> items = ConvertArchive(inputPath, outputPath, options, scheduler);
+
+        BatchCounts counts = ReportBatchItems(items);
+        fmt::print("归档转换 {} 个解决方案：成功 {} 个，失败 {} 个\n", items.size(), counts.converted, counts.failed);
+        fmt::print("已生成: {}\n", outputPath.string());
+        return counts.failed == 0 ? 0 : 1;
     }
 
-    SolutionData ParseSln(const fs::path& slnPath)
+    void RunGraphAnalysis(const fs::path& inputPath, const cxxopts::ParseResult& result)
     {
-        std::ifstream input(slnPath);
-        if (!input) {
-            throw std::runtime_error("无法打开 .sln 文件。");
-        }
-
-        SolutionData data;
-        std::string  line;
-        bool         inProject             = false;
-        bool         inProjectDependencies = false;
-        bool         inSolutionItems       = false;
-        bool         inGlobalSection       = false;
-        std::string  currentGlobalSection;
-
-        while (std::getline(input, line)) {
-            std::string trimmed = Trim(line);
-            if (trimmed.empty()) {
-                continue;
-            }
-
-            if (!inProject && StartsWith(trimmed, "Project(")) {
-                auto projectOpt = ParseProjectHeader(trimmed);
-                if (projectOpt) {
-                    data.projects.push_back(*projectOpt);
-                    ProjectEntry& entry         = data.projects.back();
-                    data.guidToName[entry.guid] = entry.name;
-                    if (!entry.isSolutionFolder) {
-                        data.guidToPath[entry.guid] = entry.path;
-                    }
-                    inProject = true;
-                }
-                continue;
-            }
+        fs::path graphPath = result["graph"].as<std::string>();
+        if (fs::exists(graphPath) && !result["force"].as<bool>()) {
+            throw std::runtime_error("依赖图输出文件已存在，使用 --force 覆盖。");
+        }
+        GraphFormat format = ResolveGraphFormat(result, graphPath);
 
-            if (inProject) {
-                if (StartsWith(trimmed, "ProjectSection(")) {
-                    if (trimmed.find("ProjectDependencies") != std::string::npos) {
-                        inProjectDependencies = true;
-                    } else if (trimmed.find("SolutionItems") != std::string::npos) {
-                        inSolutionItems = true;
-                    }
-                    continue;
-                }
-                if (StartsWith(trimmed, "EndProjectSection")) {
-                    inProjectDependencies = false;
-                    inSolutionItems       = false;
-                    continue;
-                }
-                if (StartsWith(trimmed, "EndProject")) {
-                    inProject             = false;
-                    inProjectDependencies = false;
-                    inSolutionItems       = false;
-                    continue;
-                }
+        // 依赖分析只用到项目头和 ProjectDependencies，配置映射不必解析
+        std::optional<LazySln> sln;
+        SolutionData           loaded;
+        if (inputPath.extension() == kSnapshotExtension || result["snapshot"].as<bool>()) {
+            loaded = LoadSolution(inputPath, result);
+        } else {
+            sln.emplace(inputPath);
+        }
+        const SolutionData& data     = sln ? sln->ProjectSections() : loaded;
+        DependencyGraph     graph    = BuildDependencyGraph(data);
+        GraphAnalysis       analysis = AnalyzeDependencyGraph(graph);
 
-                if (inProjectDependencies) {
-                    auto parts = SplitOnce(trimmed, '=');
-                    if (parts.size() >= 2) {
-                        std::string dep = Trim(parts[0]);
-                        if (!dep.empty()) {
-                            data.projects.back().dependencies.push_back(dep);
-                        }
-                    }
-                } else if (inSolutionItems) {
-                    auto parts = SplitOnce(trimmed, '=');
-                    if (parts.size() >= 2) {
-                        std::string item = Trim(parts[1]);
-                        if (!item.empty()) {
-                            data.projects.back().solutionItems.push_back(item);
-                        }
-                    }
-                }
-                continue;
+        for (const auto& cycle : analysis.cycles) {
+            std::string names;
+            for (uint32_t node : cycle) {
+                names += data.projects[graph.nodes[node]].name;
+                names += " -> ";
             }
+            names += data.projects[graph.nodes[cycle.front()]].name;
+            fmt::print(stderr, "警告: 检测到循环依赖: {}\n", names);
+        }
+        for (const auto& [node, guid] : graph.missingDependencies) {
+            fmt::print(stderr, "警告: 项目 {} 依赖的 {} 不在解决方案中\n", data.projects[graph.nodes[node]].name, guid);
+        }
 
-            if (StartsWith(trimmed, "GlobalSection(")) {
-                inGlobalSection = true;
-                auto start      = trimmed.find('(');
-                auto end        = trimmed.find(')');
-                if (start != std::string::npos && end != std::string::npos && end > start + 1) {
-                    currentGlobalSection = trimmed.substr(start + 1, end - start - 1);
-                } else {
-                    currentGlobalSection.clear();
-                }
-                continue;
-            }
-            if (StartsWith(trimmed, "EndGlobalSection")) {
-                inGlobalSection = false;
-                currentGlobalSection.clear();
+        WriteTextFile(graphPath, FormatGraph(data, graph, analysis, format));
+        fmt::print("项目 {} 个，构建层级 {} 层，关键路径长度 {}，循环依赖 {} 处\n", graph.nodes.size(), analysis.waves.size(),
+            analysis.criticalPath.size(), analysis.cycles.size());
+        fmt::print("已生成: {}\n", graphPath.string());
+    }
+
+    // 直接读映射的快照，不构造 SolutionData
+    void ListSnapshotProjects(const fs::path& snapshotPath)
+    {
+        SolutionSnapshot snapshot(snapshotPath);
+        std::string      out;
+        for (const auto& project : snapshot.Projects()) {
+            if (project.isSolutionFolder != 0) {
                 continue;
             }
+            out += fmt::format(
+                "{}{}\t{}\n", snapshot.String(project.folderPath), snapshot.String(project.name), snapshot.String(project.path));
+        }
+        fmt::print("{}", out);
+    }
 
-            if (inGlobalSection) {
-                if (currentGlobalSection == "SolutionConfigurationPlatforms") {
-                    ParseSolutionConfiguration(trimmed, data);
-                } else if (currentGlobalSection == "ProjectConfigurationPlatforms") {
-                    ParseProjectConfiguration(trimmed, data);
-                } else if (currentGlobalSection == "NestedProjects") {
-                    ParseNestedProject(trimmed, data);
-                }
-            }
+    // 每行一个项目：所在文件夹路径 + 项目名、制表符、项目路径
+    void RunListProjects(const fs::path& inputPath, const cxxopts::ParseResult& result)
+    {
+        if (inputPath.extension() == kSnapshotExtension) {
+            ListSnapshotProjects(inputPath);
+            return;
+        }
+        if (result["snapshot"].as<bool>()) {
+            ListSnapshotProjects(EnsureSolutionSnapshot(inputPath));
+            return;
         }
+        LazySln             sln(inputPath);
+        const SolutionData& data = sln.Nesting();
 
-        for (auto& project : data.projects) {
-            for (auto& [solutionConfig, mapping] : project.configMap) {
-                if (mapping.hasActive) {
-                    if (!mapping.buildSet) {
-                        mapping.build    = false;
-                        mapping.buildSet = true;
-                    }
-                    if (!mapping.deploySet) {
-                        mapping.deploy    = false;
-                        mapping.deploySet = true;
-                    }
-                }
+        std::unordered_map<std::string, std::string> folderPaths;
+        std::unordered_map<std::string, bool>        visiting;
+        std::string                                  out;
+        for (const auto& project : data.projects) {
+            if (project.isSolutionFolder) {
+                continue;
             }
+            auto        nested = data.nestedProjects.find(project.guid);
+            std::string folder
+                = nested == data.nestedProjects.end() ? "/" : ResolveFolderPath(nested->second, data, folderPaths, visiting);
+            out += fmt::format("{}{}\t{}\n", folder, project.name, project.path);
         }
-
-        return data;
+        fmt::print("{}", out);
     }
 
-    void AppendBuildTypesAndPlatforms(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* root, const SolutionData& data)
+    int RunConversion(const cxxopts::ParseResult& result)
     {
-        if (data.buildTypes.empty() && data.platforms.empty()) {
-            return;
+        if (result.count("batch")) {
+            return RunBatch(result);
         }
 
-        auto* configs = doc.NewElement("Configurations");
-        root->InsertEndChild(configs);
+        if (result.count("archive")) {
+            return RunArchive(result);
+        }
 
-        for (const auto& buildType : data.buildTypes) {
-            auto* elem = doc.NewElement("BuildType");
-            elem->SetAttribute("Name", buildType.c_str());
-            configs->InsertEndChild(elem);
+        if (result["merge"].as<bool>()) {
+            RunMerge(result);
+            return 0;
         }
-        for (const auto& platform : data.platforms) {
-            auto* elem = doc.NewElement("Platform");
-            elem->SetAttribute("Name", platform.c_str());
-            configs->InsertEndChild(elem);
+
+        if (result["to-sln"].as<bool>()) {
+            RunSlnxToSln(result);
+            return 0;
         }
-    }
 
-    void AppendProjectXml(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* parent, const ProjectEntry& project)
-    {
-        auto* projectElem = doc.NewElement("Project");
-        projectElem->SetAttribute("Path", project.path.c_str());
-        auto normalizedGuid = NormalizeGuidForSlnx(project.guid);
-        projectElem->SetAttribute("Id", normalizedGuid.c_str());
+        fs::path inputPath = ResolveInputPath(result["input"].as<std::string>(), ".sln");
+        if (inputPath.extension() != ".sln" && inputPath.extension() != kSnapshotExtension) {
+            throw std::runtime_error("输入文件不是 .sln 或 .slnsnap。");
+        }
 
-        parent->InsertEndChild(projectElem);
-    }
+        if (result["list-projects"].as<bool>()) {
+            RunListProjects(inputPath, result);
+            return 0;
+        }
 
-    void WriteSlnx(const fs::path& outputPath, const SolutionData& data)
-    {
-        tinyxml2::XMLDocument doc;
+        if (result.count("graph")) {
+            RunGraphAnalysis(inputPath, result);
+            return 0;
+        }
 
-        auto* root = doc.NewElement("Solution");
-        doc.InsertEndChild(root);
+        bool                     verify        = result["verify"].as<bool>();
+        std::vector<FilterQuery> filterQueries = CollectFilterQueries(result);
+        fs::path                 outputPath    = OutputPathFor(result, inputPath, ".slnx");
+        bool                     reuseOutput
+            = (verify || !filterQueries.empty()) && !result["force"].as<bool>() && fs::exists(outputPath);
 
-        AppendBuildTypesAndPlatforms(doc, root, data);
-        for (const auto& project : data.projects) {
-            if (project.isSolutionFolder) {
-                continue;
-            }
-            AppendProjectXml(doc, root, project);
+        PathChecks   checks(result);
+        SolutionData data = LoadSolution(inputPath, result);
+        checks.FixCase(data, inputPath.parent_path());
+        checks.CheckItems(data, inputPath.parent_path());
+        // 输出在其他目录时，项目与解决方案项的相对路径改为相对输出目录
+        RebaseSolutionPaths(data, inputPath.parent_path(), outputPath.parent_path());
+        if (!reuseOutput) {
+            outputPath = ResolveOutputPath(result, inputPath, ".slnx");
+            WriteSlnxFile(outputPath, data, result);
+            fmt::print("已生成: {}\n", outputPath.string());
         }
 
-        if (doc.SaveFile(outputPath.string().c_str()) != tinyxml2::XML_SUCCESS) {
-            throw std::runtime_error("写入 .slnx 文件失败。");
+        if (!filterQueries.empty()) {
+            WriteSolutionFilters(outputPath, data, filterQueries);
+        }
+        if (verify && !VerifyConversion(inputPath, outputPath, data)) {
+            return 2;
         }
+        return 0;
     }
 
 }  // namespace
@@ -486,38 +529,50 @@ int main(int argc, char** argv)
 {
     try {
         cxxopts::Options options("goto-slnx", "一键将 .sln 转换为 .slnx");
-        options.add_options()("i,input", "输入 .sln 路径（或包含单个 .sln 的目录）", cxxopts::value<std::string>())("o,output",
+        options.add_options()("i,input", "输入 .sln 路径（或包含单个 .sln 的目录），也可以是 .slnsnap 快照", cxxopts::value<std::string>())("o,output",
             "输出 .slnx 路径（默认同名）", cxxopts::value<std::string>())("f,force", "覆盖已有 .slnx 文件",
-            cxxopts::value<bool>()->default_value("false"))("h,help", "显示帮助");
+            cxxopts::value<bool>()->default_value("false"))("g,graph", "分析项目依赖（循环、构建层级、关键路径）并导出到指定文件",
+            cxxopts::value<std::string>())("graph-format", "依赖图格式：json 或 dot（默认按扩展名推断）", cxxopts::value<std::string>())(
+            "to-sln", "反向转换：将 .slnx 转换为 .sln", cxxopts::value<bool>()->default_value("false"))("list-projects",
+            "列出项目（文件夹路径/名称与项目路径），只解析项目头和 NestedProjects", cxxopts::value<bool>()->default_value("false"))(
+            "verify", "转换后读回 .slnx 并与源 .sln 做语义比对（输出已存在且未指定 --force 时只做比对）",
+            cxxopts::value<bool>()->default_value("false"))("filter-folder",
+            "为指定解决方案文件夹（含其依赖闭包）生成 .slnf，可重复", cxxopts::value<std::vector<std::string>>())("filter-project",
+            "为指定项目（名称、路径或 GUID）及其依赖闭包生成 .slnf，可重复", cxxopts::value<std::vector<std::string>>())("merge",
+            "将多个 .sln（以位置参数给出）合并为一个 .slnx，需配合 --output", cxxopts::value<bool>()->default_value("false"))(
+            "inputs", "合并模式的输入 .sln 列表", cxxopts::value<std::vector<std::string>>())("batch",
+            "递归转换目录下的全部 .sln（各自生成同名 .slnx）", cxxopts::value<std::string>())("archive",
+            "转换 .tar/.tar.gz 归档中的全部 .sln（不解压到磁盘），.slnx 写入 --output 指定的归档", cxxopts::value<std::string>())("j,jobs",
+            "工作线程数，用于批量转换和解决方案项检查（默认按 CPU 核数）", cxxopts::value<size_t>()->default_value("0"))("canonical",
+            "文件夹、项目、构建依赖和解决方案项按路径排序，输出与 .sln 中的顺序无关", cxxopts::value<bool>()->default_value("false"))("check-items",
+            "并行检查解决方案项是否存在：warn 只警告，drop 同时从输出中移除", cxxopts::value<std::string>())("trace",
+            "把各线程的解析、写出等耗时区间导出为 Chrome trace JSON（chrome://tracing 或 Perfetto 打开）", cxxopts::value<std::string>())(
+            "fix-path-case", "把项目路径与解决方案项改为磁盘上的实际大小写（在区分大小写的文件系统上转换 Windows 编写的解决方案）",
+            cxxopts::value<bool>()->default_value("false"))("snapshot",
+            "在 .sln 旁缓存解析结果（同名 .slnsnap），.sln 未改动时直接加载快照", cxxopts::value<bool>()->default_value("false"))(
+            "h,help", "显示帮助");
+        options.parse_positional({ "inputs" });
+        options.positional_help("[a.sln b.sln ...]");
 
         auto result = options.parse(argc, argv);
-        if (result.count("help") || !result.count("input")) {
+        if (result.count("help")
+            || (!result.count("input") && !result.count("batch") && !result.count("archive") && !result["merge"].as<bool>())) {
             fmt::print("{}\n", options.help());
             return 0;
         }
 
-        fs::path inputPath = ResolveInputPath(result["input"].as<std::string>());
-        if (inputPath.extension() != ".sln") {
-            throw std::runtime_error("输入文件不是 .sln。");
+        fs::path tracePath;
+        if (result.count("trace")) {
+            tracePath = result["trace"].as<std::string>();
+            SetTraceThreadName("main");
+            EnableTrace();
         }
-
-        fs::path outputPath;
-        if (result.count("output")) {
-            outputPath = result["output"].as<std::string>();
-        } else {
-            outputPath = inputPath;
-            outputPath.replace_extension(".slnx");
+        int exitCode = RunConversion(result);
+        if (!tracePath.empty()) {
+            WriteTextFile(tracePath, FormatTraceJson());
+            fmt::print("已生成: {}\n", tracePath.string());
         }
-
-        if (fs::exists(outputPath) && !result["force"].as<bool>()) {
-            throw std::runtime_error("输出 .slnx 已存在，使用 --force 覆盖。");
-        }
-
-        SolutionData data = ParseSln(inputPath);
-        WriteSlnx(outputPath, data);
-
-        fmt::print("已生成: {}\n", outputPath.string());
-        return 0;
+        return exitCode;
     } catch (const std::exception& ex) {
         fmt::print(stderr, "错误: {}\n", ex.what());
         return 1;
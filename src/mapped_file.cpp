@@ -0,0 +1,142 @@
+#include "mapped_file.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gotoslnx
+{
+
+#ifdef _WIN32
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error(fmt::format("无法打开文件: {}", path.string()));
+        }
+        LARGE_INTEGER size {};
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            throw std::runtime_error(fmt::format("无法读取文件大小: {}", path.string()));
+        }
+        m_size = static_cast<size_t>(size.QuadPart);
+        if (m_size != 0) {
+            // 映射对象持有文件的引用，句柄可以立即关闭
+            m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_mapping != nullptr) {
+                m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            }
+        }
+        CloseHandle(file);
+        if (m_size != 0 && m_data == nullptr) {
+            Close();
+            throw std::runtime_error(fmt::format("内存映射失败: {}", path.string()));
+        }
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != nullptr) {
+            CloseHandle(m_mapping);
+        }
+        m_data    = nullptr;
+        m_size    = 0;
+        m_mapping = nullptr;
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_mapping(std::exchange(other.m_mapping, nullptr))
+    {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            Close();
+            m_data    = std::exchange(other.m_data, nullptr);
+            m_size    = std::exchange(other.m_size, 0);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+        }
+        return *this;
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error(fmt::format("无法打开文件: {}", path.string()));
+        }
+        struct stat info {};
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error(fmt::format("无法读取文件大小: {}", path.string()));
+        }
+        m_size = static_cast<size_t>(info.st_size);
+        if (m_size != 0) {
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                close(fd);
+                m_size = 0;
+                throw std::runtime_error(fmt::format("内存映射失败: {}", path.string()));
+            }
+            m_data = static_cast<const char*>(data);
+        }
+        // 映射建立后不再需要描述符
+        close(fd);
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_data != nullptr) {
+            munmap(const_cast<char*>(m_data), m_size);
+        }
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+    {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            Close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+#endif
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+}  // namespace gotoslnx
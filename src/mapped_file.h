@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace gotoslnx
+{
+
+    // 只读内存映射的整个文件；空文件得到空视图
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::filesystem::path& path);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char*      Data() const { return m_data; }
+        size_t           Size() const { return m_size; }
+        std::string_view View() const { return { m_data, m_size }; }
+
+    private:
+        void Close();
+
+        const char* m_data = nullptr;
+        size_t      m_size = 0;
+#ifdef _WIN32
+        void* m_mapping = nullptr;
+#endif
+    };
+
+}  // namespace gotoslnx
@@ -0,0 +1,172 @@
+#include "path_rebase.h"
+#include "trace.h"
+
+#include <algorithm>
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        // 绝对、词法归一化且不带末尾分隔符，空路径视为当前目录
+        fs::path NormalizeDirectory(const fs::path& dir)
+        {
+            fs::path normal = fs::absolute(dir.empty() ? fs::path(".") : dir).lexically_normal();
+            if (!normal.has_filename() && normal.has_relative_path()) {
+                normal = normal.parent_path();
+            }
+            return normal;
+        }
+
+        // rewrite(path, length) 改写 path 的前 length 个字符
+        template <typename Rewrite>
+        void RewriteSolutionPaths(SolutionData& data, Rewrite&& rewrite)
+        {
+            for (auto& project : data.projects) {
+                if (!project.isSolutionFolder) {
+                    rewrite(project.path, project.path.size());
+                }
+                for (auto& item : project.solutionItems) {
+                    rewrite(item, item.size());
+                }
+            }
+            // SharedMSBuildProjectFiles 的键形如 "路径*{项目 GUID}*SharedItemsImports"，只改写路径部分
+            for (auto& section : data.properties) {
+                if (section.name != "SharedMSBuildProjectFiles") {
+                    continue;
+                }
+                for (auto& entry : section.entries) {
+                    rewrite(entry.first, std::min(entry.first.find('*'), entry.first.size()));
+                }
+            }
+            // guidToPath 与 ParseSlnText 相同：同一 GUID 以最后出现的项目为准
+            for (const auto& project : data.projects) {
+                if (!project.isSolutionFolder) {
+                    data.guidToPath[project.guid] = project.path;
+                }
+            }
+        }
+
+    }  // namespace
+
+    PathRebaser::PathRebaser(const fs::path& fromDir, const fs::path& toDir)
+        : m_fromDir(NormalizeDirectory(fromDir))
+        , m_toDir(NormalizeDirectory(toDir))
+    {
+        for (const auto& segment : m_toDir.relative_path()) {
+            m_toSegments.push_back(segment.string());
+        }
+    }
+
+    // parent 是 toDir 或其祖先时，只有沿 toDir 的下一级目录往下走才仍在 toDir 的路径上
+    bool PathRebaser::EntersTarget(const Prefix& parent, std::string_view segment) const
+    {
+        if (!parent.containsTarget) {
+            return false;
+        }
+        size_t up = parent.text.size() / 3;  // parent 是 toDir 本身时为 0，子目录都在 toDir 之下
+        return up != 0 && (up > m_toSegments.size() || m_toSegments[m_toSegments.size() - up] == segment);
+    }
+
+    std::string PathRebaser::RebaseSlow(std::string_view portable) const
+    {
+        fs::path    absolute = (m_fromDir / fs::path(portable)).lexically_normal();
+        fs::path    relative = absolute.lexically_relative(m_toDir);
+        return (relative.empty() ? absolute : relative).generic_string();
+    }
+
+    const PathRebaser::Prefix& PathRebaser::PrefixOf(const std::string& directory)
+    {
+        auto found = m_prefixes.find(directory);
+        if (found != m_prefixes.end()) {
+            return found->second;
+        }
+
+        Prefix           prefix;
+        size_t           parentSize = directory.empty() ? 0 : directory.find_last_of('/', directory.size() - 2) + 1;
+        std::string_view segment    = std::string_view(directory).substr(parentSize, directory.size() - 1 - parentSize);
+        bool             composed   = false;
+        // 盘符（C:）在 Windows 上会改变根目录，也交给词法归一化
+        if (!directory.empty() && !segment.empty() && segment != "." && segment != ".." && segment.find(':') == std::string_view::npos) {
+            // 引用在之后插入新元素时仍然有效
+            const Prefix& parent = PrefixOf(directory.substr(0, parentSize));
+            if (!EntersTarget(parent, segment)) {
+                prefix.text.reserve(parent.text.size() + segment.size() + 1);
+                prefix.text += parent.text;
+                prefix.text += segment;
+                prefix.text += '/';
+                composed = true;
+            }
+        }
+        if (!composed) {
+            prefix.text = RebaseSlow(directory.empty() ? std::string_view(".") : std::string_view(directory));
+            if (prefix.text == ".") {
+                prefix.text.clear();
+            } else if (!prefix.text.empty() && prefix.text.back() != '/') {
+                prefix.text.push_back('/');
+            }
+            // 相对路径只由 ../ 组成时，目录就是 toDir 或其祖先
+            prefix.containsTarget = true;
+            for (size_t i = 0; i < prefix.text.size(); i += 3) {
+                if (prefix.text.compare(i, 3, "../") != 0) {
+                    prefix.containsTarget = false;
+                    break;
+                }
+            }
+        }
+        return m_prefixes.emplace(directory, std::move(prefix)).first->second;
+    }
+
+    std::string PathRebaser::Rebase(std::string_view path)
+    {
+        // 一遍扫描：统一成正斜杠，同时记下最后一个分隔符
+        std::string directory(path);
+        size_t      split = 0;
+        for (size_t i = 0; i < directory.size(); ++i) {
+            if (directory[i] == '/' || directory[i] == '\\') {
+                directory[i] = '/';
+                split        = i + 1;
+            }
+        }
+        std::string_view name = path.substr(split);
+        directory.resize(split);
+        const Prefix* prefix = name.empty() || name == "." || name == ".." ? nullptr : &PrefixOf(directory);
+        if (prefix == nullptr || EntersTarget(*prefix, name)) {
+            // 以目录结尾、或正好落在 toDir 路径上的路径很少见，不走缓存
+            std::string portable(path);
+            std::replace(portable.begin(), portable.end(), '\\', '/');
+            return RebaseSlow(portable);
+        }
+
+        std::string rebased;
+        rebased.reserve(prefix->text.size() + name.size());
+        rebased += prefix->text;
+        rebased += name;
+        return rebased;
+    }
+
+    void RebaseSolutionPaths(SolutionData& data, const fs::path& fromDir, const fs::path& toDir)
+    {
+        PathRebaser rebaser(fromDir, toDir);
+        if (rebaser.IsIdentity()) {
+            // 同一目录下输出也统一分隔符，.slnx 的内容与是否指定 --output 无关
+            UseForwardSlashes(data);
+            return;
+        }
+        TraceSpan span("RebasePaths");
+        RewriteSolutionPaths(data, [&](std::string& path, size_t length) {
+            path = rebaser.Rebase(std::string_view(path).substr(0, length)) + path.substr(length);
+        });
+    }
+
+    void UseForwardSlashes(SolutionData& data)
+    {
+        RewriteSolutionPaths(data, [](std::string& path, size_t length) {
+            std::replace(path.begin(), path.begin() + static_cast<std::ptrdiff_t>(length), '\\', '/');
+        });
+    }
+
+}  // namespace gotoslnx
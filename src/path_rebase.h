@@ -0,0 +1,48 @@
+#pragma once
+
+#include "solution.h"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 把相对 fromDir 的路径改写为相对 toDir，分隔符统一为正斜杠（.slnx 的写法；写 .sln 时由 WriteSln 换回反斜杠）。
+    // 改写结果按目录前缀缓存；未命中的目录由上一级目录的结果追加一段得到，只有含 . / .. 或盘符的目录才做词法归一化
+    class PathRebaser
+    {
+    public:
+        PathRebaser(const std::filesystem::path& fromDir, const std::filesystem::path& toDir);
+
+        // 两个目录相同时路径无需改写
+        bool        IsIdentity() const { return m_fromDir == m_toDir; }
+        std::string Rebase(std::string_view path);
+
+    private:
+        struct Prefix
+        {
+            std::string text;                   // 改写后的目录前缀，为空或以正斜杠结尾
+            bool        containsTarget = false;  // 目录是 toDir 本身或其祖先，text 只由 ../ 组成
+        };
+
+        const Prefix& PrefixOf(const std::string& directory);
+        bool          EntersTarget(const Prefix& parent, std::string_view segment) const;
+        std::string   RebaseSlow(std::string_view portable) const;
+
+        std::filesystem::path                   m_fromDir;
+        std::filesystem::path                   m_toDir;
+        std::vector<std::string>                m_toSegments;  // toDir 去掉根之后的各级目录名
+        std::unordered_map<std::string, Prefix> m_prefixes;  // 正斜杠形式、以正斜杠结尾的目录部分 -> 改写结果
+    };
+
+    // 项目路径（不含解决方案文件夹）与解决方案项从 fromDir 改写到 toDir；目录相同时只把分隔符统一为正斜杠
+    void RebaseSolutionPaths(SolutionData& data, const std::filesystem::path& fromDir, const std::filesystem::path& toDir);
+
+    // 同上，只统一分隔符，供总在源文件旁输出的批量与归档转换使用
+    void UseForwardSlashes(SolutionData& data);
+
+}  // namespace gotoslnx
@@ -0,0 +1,234 @@
+#include "project_types.h"
+#include "guid_util.h"
+#include "sln_parser.h"
+
+#include <array>
+#include <optional>
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        struct KnownProjectType
+        {
+            std::string_view guid;
+            ProjectKind      kind;
+            std::string_view slnxName;   // .slnx Type 属性使用的名称，空表示直接写 GUID
+            std::string_view extension;  // 以该类型为默认的项目文件扩展名
+        };
+
+        constexpr std::array<KnownProjectType, 26> kKnownTypes = { {
+            { "{2150E333-8FDC-42A3-9474-1A3956D46DE8}", ProjectKind::SolutionFolder, "", "" },
+            { "{66A26720-8FB5-11D2-AA7E-00C04F688DDE}", ProjectKind::SolutionItems, "", "" },
+            { "{9A19103F-16F7-4668-BE54-9A1E7A4F7556}", ProjectKind::CSharp, "C#", ".csproj" },
+            { "{FAE04EC0-301F-11D3-BF4B-00C04F79EFBC}", ProjectKind::ClassicCSharp, "Classic C#", "" },
+            { "{778DAE3C-4631-46EA-AA77-85C1314464D9}", ProjectKind::VisualBasic, "VB", ".vbproj" },
+            { "{F184B08F-C81C-45F6-A57F-5ABD9991F28F}", ProjectKind::ClassicVisualBasic, "Classic VB", "" },
+            { "{6EC3EE1D-3C4E-46DD-8F32-0CC8E7565705}", ProjectKind::FSharp, "F#", ".fsproj" },
+            { "{F2A71F9B-5D33-465A-A702-920D77279786}", ProjectKind::ClassicFSharp, "Classic F#", "" },
+            { "{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}", ProjectKind::Cpp, "C++", ".vcxproj" },
+            { "{D954291E-2A0B-460D-934E-DC6B0785DB48}", ProjectKind::SharedProject, "", ".shproj" },
+            { "{E24C65DC-7377-472B-9ABA-BC803B73C61A}", ProjectKind::WebSite, "Website", "" },
+            { "{349C5851-65DF-11DA-9384-00065B846F21}", ProjectKind::WebApplication, "", "" },
+            { "{00D1A9C2-B5F0-4AF3-8072-F6C62B433612}", ProjectKind::Database, "", ".sqlproj" },
+            { "{888888A0-9F3D-457C-B088-3A5042F75D52}", ProjectKind::Python, "", ".pyproj" },
+            { "{9092AA53-FB77-4645-B42D-1CCCA6BD08BD}", ProjectKind::NodeJs, "", ".njsproj" },
+            { "{54A90642-561A-4BB1-A94E-469ADEE60C69}", ProjectKind::JavaScript, "", ".esproj" },
+            { "{C7167F0D-BC9F-4E6E-AFE1-012C56B48DB5}", ProjectKind::Packaging, "", ".wapproj" },
+            { "{930C7802-8A8C-48F9-8165-68863BCCD9DD}", ProjectKind::Wix, "", ".wixproj" },
+            { "{E53339B2-1760-4266-BCC7-CA923CBCF16C}", ProjectKind::DockerCompose, "", ".dcproj" },
+            { "{54435603-DBB4-11D2-8724-00A0C9A8B90C}", ProjectKind::Setup, "", ".vdproj" },
+            { "{CC5FD16D-436D-48AD-A40C-5A424C6E3E79}", ProjectKind::CloudService, "", ".ccproj" },
+            { "{A07B5EB6-E848-4116-A8D0-A826331D98C6}", ProjectKind::ServiceFabric, "", ".sfproj" },
+            { "{8BB2217D-0F2D-49D1-97BC-3654ED321F3B}", ProjectKind::CSharp, "", ".xproj" },
+            { "{3AC096D0-A1C2-E12C-1390-A8335801FDAB}", ProjectKind::ClassicCSharp, "", "" },
+            { "{60DC8134-EBA5-43B8-BCC9-BB4BC16C2548}", ProjectKind::ClassicCSharp, "", "" },
+            { "{A1591282-1198-4647-A2B1-27E5FF5F6F3B}", ProjectKind::ClassicCSharp, "", "" },
+        } };
+
+        // 扩展名无法识别时按 SDK 风格 C# 项目处理；共享 C++ 项（.vcxitems）沿用 C++ 项目类型
+        constexpr std::string_view kDefaultTypeGuid      = "{9A19103F-16F7-4668-BE54-9A1E7A4F7556}";
+        constexpr std::string_view kCppTypeGuid          = "{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}";
+        constexpr std::string_view kSharedItemsExtension = ".vcxitems";
+
+        struct GuidBits
+        {
+            uint64_t high = 0;
+            uint64_t low  = 0;
+
+            constexpr bool operator==(const GuidBits&) const = default;
+        };
+
+        constexpr int HexValue(char ch)
+        {
+            if (ch >= '0' && ch <= '9') {
+                return ch - '0';
+            }
+            if (ch >= 'a' && ch <= 'f') {
+                return ch - 'a' + 10;
+            }
+            if (ch >= 'A' && ch <= 'F') {
+                return ch - 'A' + 10;
+            }
+            return -1;
+        }
+
+        constexpr std::optional<GuidBits> ParseGuidBits(std::string_view text)
+        {
+            if (text.size() == 38 && text.front() == '{' && text.back() == '}') {
+                text = text.substr(1, 36);
+            }
+            if (text.size() != 36) {
+                return std::nullopt;
+            }
+            GuidBits bits;
+            int      nibbles = 0;
+            for (size_t i = 0; i < text.size(); ++i) {
+                if (i == 8 || i == 13 || i == 18 || i == 23) {
+                    if (text[i] != '-') {
+                        return std::nullopt;
+                    }
+                    continue;
+                }
+                int value = HexValue(text[i]);
+                if (value < 0) {
+                    return std::nullopt;
+                }
+                uint64_t& word = nibbles < 16 ? bits.high : bits.low;
+                word           = (word << 4) | static_cast<uint64_t>(value);
+                ++nibbles;
+            }
+            return bits;
+        }
+
+        constexpr std::array<GuidBits, kKnownTypes.size()> BuildKnownBits()
+        {
+            std::array<GuidBits, kKnownTypes.size()> bits {};
+            for (size_t i = 0; i < kKnownTypes.size(); ++i) {
+                bits[i] = *ParseGuidBits(kKnownTypes[i].guid);
+            }
+            return bits;
+        }
+
+        // 与 kKnownTypes 一一对应，查找时只需解析输入的 GUID
+        constexpr std::array<GuidBits, kKnownTypes.size()> kKnownBits = BuildKnownBits();
+
+        constexpr int      kSlotBits  = 6;
+        constexpr size_t   kSlotCount = size_t(1) << kSlotBits;
+        constexpr uint8_t  kEmptySlot = 0xFF;
+
+        constexpr size_t SlotOf(const GuidBits& bits, uint64_t seed)
+        {
+            uint64_t key = bits.high ^ (bits.low * 0x9E3779B97F4A7C15ULL);
+            return static_cast<size_t>((key * seed) >> (64 - kSlotBits));
+        }
+
+        // 编译期搜索一个使所有已知 GUID 落入不同槽位的乘数
+        constexpr uint64_t FindPerfectSeed()
+        {
+            for (uint64_t seed = 0x9E3779B97F4A7C15ULL;; seed += 0x632BE59BD9B4E019ULL) {
+                std::array<bool, kSlotCount> used {};
+                bool                         collision = false;
+                for (const auto& bits : kKnownBits) {
+                    size_t slot = SlotOf(bits, seed | 1);
+                    collision   = collision || used[slot];
+                    used[slot]  = true;
+                }
+                if (!collision) {
+                    return seed | 1;
+                }
+            }
+        }
+
+        constexpr uint64_t kPerfectSeed = FindPerfectSeed();
+
+        constexpr std::array<uint8_t, kSlotCount> BuildSlotTable()
+        {
+            std::array<uint8_t, kSlotCount> slots {};
+            for (auto& slot : slots) {
+                slot = kEmptySlot;
+            }
+            for (size_t i = 0; i < kKnownTypes.size(); ++i) {
+                slots[SlotOf(kKnownBits[i], kPerfectSeed)] = static_cast<uint8_t>(i);
+            }
+            return slots;
+        }
+
+        constexpr std::array<uint8_t, kSlotCount> kSlotTable = BuildSlotTable();
+
+        constexpr const KnownProjectType* FindKnownType(std::string_view typeGuid)
+        {
+            auto bits = ParseGuidBits(typeGuid);
+            if (!bits) {
+                return nullptr;
+            }
+            uint8_t entry = kSlotTable[SlotOf(*bits, kPerfectSeed)];
+            if (entry == kEmptySlot || kKnownBits[entry] != *bits) {
+                return nullptr;
+            }
+            return &kKnownTypes[entry];
+        }
+
+        static_assert(FindKnownType("{2150e333-8fdc-42a3-9474-1a3956d46de8}")->kind == ProjectKind::SolutionFolder);
+        static_assert(FindKnownType("D954291E-2A0B-460D-934E-DC6B0785DB48")->kind == ProjectKind::SharedProject);
+        static_assert(FindKnownType("{00000000-0000-0000-0000-000000000000}") == nullptr);
+
+        const KnownProjectType* FindTypeByExtension(std::string_view path)
+        {
+            auto dot = path.rfind('.');
+            if (dot == std::string_view::npos) {
+                return nullptr;
+            }
+            std::string_view extension = path.substr(dot);
+            if (EqualsIgnoreCase(extension, kSharedItemsExtension)) {
+                return FindKnownType(kCppTypeGuid);
+            }
+            for (const auto& type : kKnownTypes) {
+                if (!type.extension.empty() && EqualsIgnoreCase(type.extension, extension)) {
+                    return &type;
+                }
+            }
+            return nullptr;
+        }
+
+    }  // namespace
+
+    ProjectKind ClassifyProjectType(std::string_view typeGuid)
+    {
+        const KnownProjectType* type = FindKnownType(typeGuid);
+        return type == nullptr ? ProjectKind::Unknown : type->kind;
+    }
+
+    std::string ProjectTypeGuidForSlnx(std::string_view path, std::string_view typeAttribute)
+    {
+        if (!typeAttribute.empty()) {
+            if (IsGuidText(typeAttribute)) {
+                return FormatGuidForSln(typeAttribute);
+            }
+            for (const auto& type : kKnownTypes) {
+                if (!type.slnxName.empty() && EqualsIgnoreCase(type.slnxName, typeAttribute)) {
+                    return std::string(type.guid);
+                }
+            }
+        }
+
+        const KnownProjectType* type = FindTypeByExtension(path);
+        return std::string(type == nullptr ? kDefaultTypeGuid : type->guid);
+    }
+
+    std::string SlnxTypeAttribute(std::string_view path, std::string_view typeGuid)
+    {
+        const KnownProjectType* byExtension = FindTypeByExtension(path);
+        const KnownProjectType* known       = FindKnownType(typeGuid);
+        if (known != nullptr && known == byExtension) {
+            return std::string();
+        }
+        if (known != nullptr && !known->slnxName.empty()) {
+            return std::string(known->slnxName);
+        }
+        return NormalizeGuidForSlnx(typeGuid);
+    }
+
+}  // namespace gotoslnx
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace gotoslnx
+{
+
+    enum class ProjectKind : uint8_t
+    {
+        Unknown,
+        SolutionFolder,
+        SolutionItems,
+        CSharp,
+        ClassicCSharp,
+        VisualBasic,
+        ClassicVisualBasic,
+        FSharp,
+        ClassicFSharp,
+        Cpp,
+        SharedProject,
+        WebSite,
+        WebApplication,
+        Database,
+        Python,
+        NodeJs,
+        JavaScript,
+        Packaging,
+        Wix,
+        DockerCompose,
+        Setup,
+        CloudService,
+        ServiceFabric,
+    };
+
+    // 通过编译期生成的完美哈希表识别项目类型 GUID（大小写无关，花括号可选），不分配内存
+    ProjectKind ClassifyProjectType(std::string_view typeGuid);
+
+    // 共享项目只被其他项目引用，本身没有配置映射
+    inline bool HasConfigurations(ProjectKind kind)
+    {
+        return kind != ProjectKind::SolutionFolder && kind != ProjectKind::SolutionItems && kind != ProjectKind::SharedProject;
+    }
+
+    // 根据 .slnx 中的 Type 属性或项目文件扩展名推断 .sln 所需的项目类型 GUID
+    std::string ProjectTypeGuidForSlnx(std::string_view path, std::string_view typeAttribute);
+
+    // .slnx 中需要写出的 Type 属性；类型能由扩展名推断出时返回空
+    std::string SlnxTypeAttribute(std::string_view path, std::string_view typeGuid);
+
+}  // namespace gotoslnx
@@ -0,0 +1,983 @@
+#include "sln_parser.h"
+#include "guid_util.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        std::string_view TrimView(std::string_view input)
+        {
+            size_t start = 0;
+            while (start < input.size() && std::isspace(static_cast<unsigned char>(input[start]))) {
+                ++start;
+            }
+            size_t end = input.size();
+            while (end > start && std::isspace(static_cast<unsigned char>(input[end - 1]))) {
+                --end;
+            }
+            return input.substr(start, end - start);
+        }
+
+        enum class ConfigSuffix : uint8_t
+        {
+            ActiveCfg,
+            Build,
+            Deploy,
+            Other,
+        };
+
+        // ProjectConfigurationPlatforms 中一行拆出的各部分，均为原文的视图
+        struct ProjectConfigurationLine
+        {
+            std::string_view guid;
+            std::string_view solutionConfig;
+            ConfigSuffix     suffix = ConfigSuffix::Other;
+            std::string_view value;
+        };
+
+        bool SplitProjectConfigurationLine(std::string_view line, ProjectConfigurationLine& parsed)
+        {
+            auto equals = line.find('=');
+            if (equals == std::string_view::npos) {
+                return false;
+            }
+            std::string_view left = TrimView(line.substr(0, equals));
+            parsed.value          = TrimView(line.substr(equals + 1));
+
+            if (!StartsWith(left, "{")) {
+                return false;
+            }
+            auto guidEnd = left.find('}');
+            if (guidEnd == std::string_view::npos) {
+                return false;
+            }
+            parsed.guid                = left.substr(0, guidEnd + 1);
+            std::string_view remainder = left.substr(guidEnd + 1);
+            if (remainder.empty() || remainder[0] != '.') {
+                return false;
+            }
+            remainder.remove_prefix(1);
+
+            auto lastDot = remainder.rfind('.');
+            if (lastDot == std::string_view::npos) {
+                return false;
+            }
+            // Build.0 / Deploy.0 带有数字索引，后缀需要再向前取一段
+            if (lastDot + 1 < remainder.size()
+                && std::all_of(remainder.begin() + lastDot + 1, remainder.end(), [](unsigned char ch) { return std::isdigit(ch); })) {
+                auto previousDot = lastDot == 0 ? std::string_view::npos : remainder.rfind('.', lastDot - 1);
+                if (previousDot == std::string_view::npos) {
+                    return false;
+                }
+                lastDot = previousDot;
+            }
+            parsed.solutionConfig   = remainder.substr(0, lastDot);
+            std::string_view suffix = remainder.substr(lastDot + 1);
+            parsed.suffix           = suffix == "ActiveCfg"     ? ConfigSuffix::ActiveCfg
+                                    : StartsWith(suffix, "Build")  ? ConfigSuffix::Build
+                                    : StartsWith(suffix, "Deploy") ? ConfigSuffix::Deploy
+                                                                   : ConfigSuffix::Other;
+            return true;
+        }
+
+        // 与 SplitConfig 相同，返回视图
+        std::pair<std::string_view, std::string_view> SplitConfigView(std::string_view config)
+        {
+            auto bar = config.find('|');
+            if (bar == std::string_view::npos) {
+                return { TrimView(config), {} };
+            }
+            return { TrimView(config.substr(0, bar)), TrimView(config.substr(bar + 1)) };
+        }
+
+        // ActiveCfg 总是改写项目配置；Build / Deploy 带值且该行尚无 ActiveCfg 时也用它激活
+        template <typename Activate>
+        void ApplyConfigSuffix(ConfigSuffix suffix, bool hasValue, uint8_t& flags, Activate&& activate)
+        {
+            switch (suffix) {
+                case ConfigSuffix::ActiveCfg:
+                    activate();
+                    break;
+                case ConfigSuffix::Build:
+                    flags |= kMappingBuild;
+                    if (hasValue && !(flags & kMappingActive)) {
+                        activate();
+                    }
+                    break;
+                case ConfigSuffix::Deploy:
+                    flags |= kMappingDeploy;
+                    if (hasValue && !(flags & kMappingActive)) {
+                        activate();
+                    }
+                    break;
+                case ConfigSuffix::Other:
+                    break;
+            }
+        }
+
+        // 配置行中的项目 GUID 通常是规范的带花括号形式，解码后按字节查找，既不分配也不区分大小写；
+        // 无法解码的写法很少见，按原文查 guidToIndex
+        std::optional<size_t> FindProjectIndex(const SolutionData& data, std::string_view guid)
+        {
+            if (GuidBytes bytes; DecodeBracedGuid(guid, bytes)) {
+                auto found = data.guidBytesToIndex.find(bytes);
+                if (found == data.guidBytesToIndex.end()) {
+                    return std::nullopt;
+                }
+                return found->second;
+            }
+            auto found = data.guidToIndex.find(std::string(guid));
+            if (found == data.guidToIndex.end()) {
+                return std::nullopt;
+            }
+            return found->second;
+        }
+
+    }  // namespace
+
+    std::string Trim(std::string_view input)
+    {
+        return std::string(TrimView(input));
+    }
+
+    bool StartsWith(std::string_view text, std::string_view prefix)
+    {
+        return text.size() >= prefix.size() && text.substr(0, prefix.size()) == prefix;
+    }
+
+    bool EqualsIgnoreCase(std::string_view left, std::string_view right)
+    {
+        return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin(), [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        });
+    }
+
+    std::vector<std::string> SplitOnce(std::string_view text, char delimiter)
+    {
+        auto pos = text.find(delimiter);
+        if (pos == std::string_view::npos) {
+            return { std::string(text) };
+        }
+        return { std::string(text.substr(0, pos)), std::string(text.substr(pos + 1)) };
+    }
+
+    std::pair<std::string, std::string> SplitConfig(const std::string& config)
+    {
+        auto parts = SplitOnce(config, '|');
+        if (parts.size() == 1) {
+            return { Trim(parts[0]), std::string() };
+        }
+        return { Trim(parts[0]), Trim(parts[1]) };
+    }
+
+    std::optional<ProjectEntry> ParseProjectHeader(const std::string& line)
+    {
+        // 手写扫描，语义等价于
+        // ^Project\("\{([^}]+)\}"\)\s*=\s*"([^"]+)",\s*"([^"]+)",\s*"\{([^}]+)\}"\s*$
+        // 每个字段只向前查找一次终止符，最坏情况也是线性时间
+        std::string_view rest = line;
+
+        auto consume = [&](std::string_view token) {
+            if (!StartsWith(rest, token)) {
+                return false;
+            }
+            rest.remove_prefix(token.size());
+            return true;
+        };
+        auto skipSpace = [&] {
+            while (!rest.empty() && std::isspace(static_cast<unsigned char>(rest.front()))) {
+                rest.remove_prefix(1);
+            }
+        };
+        auto readUntil = [&](char terminator, std::string_view& field) {
+            auto end = rest.find(terminator);
+            if (end == 0 || end == std::string_view::npos) {
+                return false;
+            }
+            field = rest.substr(0, end);
+            rest.remove_prefix(end);
+            return true;
+        };
+
+        std::string_view typeGuid, name, path, guid;
+        if (!consume("Project(\"{") || !readUntil('}', typeGuid) || !consume("}\")")) {
+            return std::nullopt;
+        }
+        skipSpace();
+        if (!consume("=")) {
+            return std::nullopt;
+        }
+        skipSpace();
+        if (!consume("\"") || !readUntil('"', name) || !consume("\",")) {
+            return std::nullopt;
+        }
+        skipSpace();
+        if (!consume("\"") || !readUntil('"', path) || !consume("\",")) {
+            return std::nullopt;
+        }
+        skipSpace();
+        if (!consume("\"{") || !readUntil('}', guid) || !consume("}\"")) {
+            return std::nullopt;
+        }
+        skipSpace();
+        if (!rest.empty()) {
+            return std::nullopt;
+        }
+
+        ProjectEntry entry;
+        entry.typeGuid.reserve(typeGuid.size() + 2);
+        entry.typeGuid.append(1, '{').append(typeGuid).append(1, '}');
+        entry.name = std::string(name);
+        entry.path = std::string(path);
+        entry.guid.reserve(guid.size() + 2);
+        entry.guid.append(1, '{').append(guid).append(1, '}');
+        entry.kind             = ClassifyProjectType(typeGuid);
+        entry.isSolutionFolder = entry.kind == ProjectKind::SolutionFolder || entry.kind == ProjectKind::SolutionItems;
+        return entry;
+    }
+
+    void ParseSolutionConfiguration(const std::string& line, SolutionData& data)
+    {
+        auto parts = SplitOnce(line, '=');
+        if (parts.empty()) {
+            return;
+        }
+        std::string left = Trim(parts[0]);
+        if (left.empty()) {
+            return;
+        }
+        data.solutionConfigs.insert(left);
+        auto configParts = SplitConfig(left);
+        if (!configParts.first.empty()) {
+            data.buildTypes.insert(configParts.first);
+        }
+        if (!configParts.second.empty()) {
+            data.platforms.insert(configParts.second);
+        }
+    }
+
+    void ParseProjectConfiguration(const std::string& line, SolutionData& data)
+    {
+        ProjectConfigurationLine parsed;
+        if (!SplitProjectConfigurationLine(line, parsed)) {
+            return;
+        }
+        data.solutionConfigs.emplace(parsed.solutionConfig);
+
+        auto project = FindProjectIndex(data, parsed.guid);
+        if (!project) {
+            return;
+        }
+
+        ConfigMappingTable& table    = data.configs;
+        uint32_t            configId = data.strings.Intern(parsed.solutionConfig);
+        uint32_t            row      = table.Upsert(static_cast<uint32_t>(*project), configId).first;
+        ApplyConfigSuffix(parsed.suffix, !parsed.value.empty(), table.flags[row], [&] {
+            auto configParts      = SplitConfigView(parsed.value);
+            table.buildTypes[row] = data.strings.Intern(configParts.first);
+            table.platforms[row]  = data.strings.Intern(configParts.second);
+            table.flags[row] |= kMappingActive;
+        });
+    }
+
+    void ParseNestedProject(const std::string& line, SolutionData& data)
+    {
+        auto parts = SplitOnce(line, '=');
+        if (parts.size() < 2) {
+            return;
+        }
+        std::string child  = Trim(parts[0]);
+        std::string parent = Trim(parts[1]);
+        if (child.empty() || parent.empty()) {
+            return;
+        }
+        data.nestedProjects[child] = parent;
+    }
+
+    std::string NormalizeFolderPath(const std::vector<std::string>& segments)
+    {
+        std::string path = "/";
+        for (const auto& segment : segments) {
+            if (!segment.empty()) {
+                path += segment;
+                if (path.back() != '/') {
+                    path += '/';
+                }
+            }
+        }
+        return path;
+    }
+
+    std::string ResolveFolderPath(const std::string& folderGuid, const SolutionData& data,
+        std::unordered_map<std::string, std::string>& cache, std::unordered_map<std::string, bool>& visiting)
+    {
+        // 先沿 NestedProjects 向上收集未解析的祖先，再自顶向下拼接，嵌套再深也不会耗尽调用栈
+        std::vector<const std::string*> chain;
+        std::string                     base    = "/";
+        const std::string*              current = &folderGuid;
+        while (true) {
+            auto cached = cache.find(*current);
+            if (cached != cache.end()) {
+                base = cached->second;
+                break;
+            }
+            bool& onChain = visiting[*current];
+            if (onChain) {
+                break;
+            }
+            onChain = true;
+            chain.push_back(current);
+
+            auto parentIter = data.nestedProjects.find(*current);
+            if (parentIter == data.nestedProjects.end()) {
+                break;
+            }
+            current = &parentIter->second;
+        }
+
+        for (auto iter = chain.rbegin(); iter != chain.rend(); ++iter) {
+            std::string path     = base;
+            auto        nameIter = data.guidToName.find(**iter);
+            if (nameIter != data.guidToName.end() && !nameIter->second.empty()) {
+                path += nameIter->second;
+                if (path.back() != '/') {
+                    path += '/';
+                }
+            }
+            cache[**iter]    = path;
+            visiting[**iter] = false;
+            base             = std::move(path);
+        }
+        return cache.at(folderGuid);
+    }
+
+    std::string NormalizeGuidForSlnx(std::string_view guid)
+    {
+        // 几乎都是规范的带花括号形式，解码后直接编码为小写；其余逐字符去掉花括号并转小写
+        GuidBytes bytes;
+        if (DecodeBracedGuid(guid, bytes)) {
+            std::string output(kSlnxGuidLength, '\0');
+            EncodeGuidLower(bytes, output.data());
+            return output;
+        }
+        std::string output;
+        output.reserve(guid.size());
+        for (unsigned char ch : guid) {
+            if (ch == '{' || ch == '}') {
+                continue;
+            }
+            output.push_back(static_cast<char>(std::tolower(ch)));
+        }
+        return output;
+    }
+
+    namespace
+    {
+
+        constexpr size_t kReadBlockSize = 256 * 1024;
+        // ProjectConfigurationPlatforms 并行解析时每块的字节数，块边界对齐到行尾
+        constexpr size_t kConfigChunkSize = 1024 * 1024;
+
+        // 解析项目头并登记到 data；格式不对时返回 false
+        bool AddProjectHeader(const std::string& trimmed, SolutionData& data)
+        {
+            auto projectOpt = ParseProjectHeader(trimmed);
+            if (!projectOpt) {
+                return false;
+            }
+            data.projects.push_back(std::move(*projectOpt));
+            ProjectEntry& entry         = data.projects.back();
+            data.guidToName[entry.guid] = entry.name;
+            data.guidToIndex.emplace(entry.guid, data.projects.size() - 1);
+            if (GuidBytes bytes; DecodeBracedGuid(entry.guid, bytes)) {
+                data.guidBytesToIndex.emplace(bytes, data.projects.size() - 1);
+            }
+            if (!entry.isSolutionFolder) {
+                data.guidToPath[entry.guid] = entry.path;
+            }
+            return true;
+        }
+
+        // 解析 "GlobalSection(Name) = preSolution"、"ProjectSection(Name) = postProject" 形式的区段头，条目留空
+        PropertySection ParseSectionHeader(std::string_view trimmed)
+        {
+            PropertySection header;
+            auto            start = trimmed.find('(');
+            auto            end   = trimmed.find(')');
+            if (start != std::string_view::npos && end != std::string_view::npos && end > start + 1) {
+                header.name = std::string(trimmed.substr(start + 1, end - start - 1));
+                auto equals = trimmed.find('=', end);
+                if (equals != std::string_view::npos) {
+                    header.postLoad = StartsWith(TrimView(trimmed.substr(equals + 1)), "post");
+                }
+            }
+            return header;
+        }
+
+        void AddPropertyEntry(const std::string& trimmed, PropertySection& section)
+        {
+            auto parts = SplitOnce(trimmed, '=');
+            if (parts.size() >= 2) {
+                std::string key = Trim(parts[0]);
+                if (!key.empty()) {
+                    section.entries.emplace_back(std::move(key), Trim(parts[1]));
+                }
+            }
+        }
+
+        struct GlobalSectionHandler
+        {
+            std::string_view name;
+            const char*      traceName;
+            void (*feedLine)(const std::string& trimmed, SolutionData& data);
+        };
+
+        // 下标即 GlobalSectionKind
+        constexpr GlobalSectionHandler kGlobalSectionHandlers[] = {
+            { "SolutionConfigurationPlatforms", "ParseSln/SolutionConfigurationPlatforms", ParseSolutionConfiguration },
+            { "ProjectConfigurationPlatforms", "ParseSln/ProjectConfigurationPlatforms", ParseProjectConfiguration },
+            { "NestedProjects", "ParseSln/NestedProjects", ParseNestedProject },
+            { {}, "ParseSln/GlobalSection",
+                [](const std::string& trimmed, SolutionData& data) { AddPropertyEntry(trimmed, data.properties.back()); } },
+            { {}, "ParseSln/GlobalSection", [](const std::string&, SolutionData&) {} },
+        };
+        static_assert(std::size(kGlobalSectionHandlers) == static_cast<size_t>(GlobalSectionKind::Ignored) + 1);
+
+        const GlobalSectionHandler& HandlerFor(GlobalSectionKind kind)
+        {
+            return kGlobalSectionHandlers[static_cast<size_t>(kind)];
+        }
+
+        GlobalSectionKind ResolveGlobalSection(std::string_view name)
+        {
+            if (name.empty()) {
+                return GlobalSectionKind::Ignored;
+            }
+            for (size_t kind = 0; kind < static_cast<size_t>(GlobalSectionKind::Properties); ++kind) {
+                if (kGlobalSectionHandlers[kind].name == name) {
+                    return static_cast<GlobalSectionKind>(kind);
+                }
+            }
+            return GlobalSectionKind::Properties;
+        }
+
+        // Project 与 EndProject 之间当前所在的 ProjectSection
+        enum class ProjectSectionKind : uint8_t
+        {
+            None,
+            Dependencies,
+            SolutionItems,
+            Properties,  // 其余命名区段，条目追加到 ProjectEntry::properties 的末尾
+        };
+
+        struct ProjectBodyState
+        {
+            ProjectSectionKind section = ProjectSectionKind::None;
+        };
+
+        // 处理项目体中已去除首尾空白的一行；遇到 EndProject 时返回 false
+        bool FeedProjectBodyLine(const std::string& trimmed, ProjectEntry& project, ProjectBodyState& state)
+        {
+            if (StartsWith(trimmed, "ProjectSection(")) {
+                PropertySection header = ParseSectionHeader(trimmed);
+                if (header.name == "ProjectDependencies") {
+                    state.section = ProjectSectionKind::Dependencies;
+                } else if (header.name == "SolutionItems") {
+                    state.section = ProjectSectionKind::SolutionItems;
+                } else if (!header.name.empty()) {
+                    state.section = ProjectSectionKind::Properties;
+                    project.properties.push_back(std::move(header));
+                }
+                return true;
+            }
+            if (StartsWith(trimmed, "EndProjectSection")) {
+                state = {};
+                return true;
+            }
+            if (StartsWith(trimmed, "EndProject")) {
+                state = {};
+                return false;
+            }
+
+            switch (state.section) {
+                case ProjectSectionKind::Dependencies: {
+                    auto parts = SplitOnce(trimmed, '=');
+                    if (parts.size() >= 2) {
+                        std::string dep = Trim(parts[0]);
+                        if (!dep.empty()) {
+                            project.dependencies.push_back(dep);
+                        }
+                    }
+                    break;
+                }
+                case ProjectSectionKind::SolutionItems: {
+                    auto parts = SplitOnce(trimmed, '=');
+                    if (parts.size() >= 2) {
+                        std::string item = Trim(parts[1]);
+                        if (!item.empty()) {
+                            project.solutionItems.push_back(item);
+                        }
+                    }
+                    break;
+                }
+                case ProjectSectionKind::Properties:
+                    AddPropertyEntry(trimmed, project.properties.back());
+                    break;
+                case ProjectSectionKind::None:
+                    break;
+            }
+            return true;
+        }
+
+        // 逐行驱动的解析状态机，输入不必整体驻留内存
+        class SlnLineParser
+        {
+        public:
+            void Feed(std::string_view line)
+            {
+                std::string trimmed = Trim(line);
+                if (trimmed.empty()) {
+                    return;
+                }
+
+                if (!m_inProject && StartsWith(trimmed, "Project(")) {
+                    if (m_traceSection == nullptr) {
+                        BeginTraceSection("ParseSln/Projects");
+                    }
+                    m_inProject = AddProjectHeader(trimmed, m_data);
+                    return;
+                }
+
+                if (m_inProject) {
+                    if (!FeedProjectBodyLine(trimmed, m_data.projects.back(), m_projectBody)) {
+                        m_inProject = false;
+                    }
+                    return;
+                }
+
+                if (StartsWith(trimmed, "GlobalSection(")) {
+                    PropertySection   header = ParseSectionHeader(trimmed);
+                    GlobalSectionKind kind   = ResolveGlobalSection(header.name);
+                    if (kind == GlobalSectionKind::Properties) {
+                        m_data.properties.push_back(std::move(header));
+                    }
+                    m_globalHandler = &HandlerFor(kind);
+                    BeginTraceSection(m_globalHandler->traceName);
+                    return;
+                }
+                if (StartsWith(trimmed, "EndGlobalSection")) {
+                    m_globalHandler = nullptr;
+                    EndTraceSection();
+                    return;
+                }
+
+                if (m_globalHandler != nullptr) {
+                    m_globalHandler->feedLine(trimmed, m_data);
+                }
+            }
+
+            SolutionData Finish()
+            {
+                EndTraceSection();
+                // 缺省的 Build / Deploy 视为 false，由 Seal() 生成位集时按字与上 ActiveCfg 完成
+                {
+                    TraceSpan span("ParseSln/Seal");
+                    m_data.configs.Seal(m_data.projects.size());
+                }
+                return std::move(m_data);
+            }
+
+        private:
+            // 区段按行流式解析，没有天然的作用域，起止由行状态驱动
+            void BeginTraceSection(const char* name)
+            {
+                if (TraceEnabled()) {
+                    EndTraceSection();
+                    m_traceSection = name;
+                    m_traceStart   = TraceNow();
+                }
+            }
+
+            void EndTraceSection()
+            {
+                if (m_traceSection != nullptr) {
+                    RecordTraceSpan(m_traceSection, m_traceStart, TraceNow());
+                    m_traceSection = nullptr;
+                }
+            }
+
+            SolutionData                m_data;
+            bool                        m_inProject = false;
+            ProjectBodyState            m_projectBody;
+            const GlobalSectionHandler* m_globalHandler = nullptr;  // 不在 GlobalSection 中时为空
+            const char*                 m_traceSection  = nullptr;
+            uint64_t                    m_traceStart    = 0;
+        };
+
+        constexpr uint32_t kUnknownProject = UINT32_MAX;
+
+        // 一块 ProjectConfigurationPlatforms 的解析结果。字符串只在块内编号，合并时才驻留到 SolutionData::strings，
+        // 驻留的先后与逐行解析相同
+        struct ConfigChunk
+        {
+            struct Line
+            {
+                uint32_t     project        = kUnknownProject;
+                uint32_t     solutionConfig = 0;  // 以下均为 strings 的下标
+                uint32_t     buildType      = 0;
+                uint32_t     platform       = 0;
+                ConfigSuffix suffix         = ConfigSuffix::Other;
+                bool         hasValue       = false;
+            };
+
+            std::vector<std::string_view> strings;
+            std::vector<Line>             lines;
+        };
+
+        void ParseConfigChunk(std::string_view text, const SolutionData& data, ConfigChunk& chunk)
+        {
+            TraceSpan span("ParseSln/ProjectConfigurationPlatforms");
+
+            std::unordered_map<std::string_view, uint32_t> ids;
+            auto                                           localId = [&](std::string_view value) {
+                auto [iter, inserted] = ids.emplace(value, static_cast<uint32_t>(chunk.strings.size()));
+                if (inserted) {
+                    chunk.strings.push_back(value);
+                }
+                return iter->second;
+            };
+
+            size_t lineStart = 0;
+            while (lineStart < text.size()) {
+                size_t lineEnd = text.find('\n', lineStart);
+                if (lineEnd == std::string_view::npos) {
+                    lineEnd = text.size();
+                }
+                ProjectConfigurationLine parsed;
+                if (SplitProjectConfigurationLine(text.substr(lineStart, lineEnd - lineStart), parsed)) {
+                    ConfigChunk::Line& line = chunk.lines.emplace_back();
+                    line.solutionConfig     = localId(parsed.solutionConfig);
+                    line.suffix             = parsed.suffix;
+                    line.hasValue           = !parsed.value.empty();
+                    if (auto project = FindProjectIndex(data, parsed.guid)) {
+                        line.project     = static_cast<uint32_t>(*project);
+                        auto configParts = SplitConfigView(parsed.value);
+                        line.buildType   = localId(configParts.first);
+                        line.platform    = localId(configParts.second);
+                    }
+                }
+                lineStart = lineEnd + 1;
+            }
+        }
+
+        // 按文件顺序重放一块的各行，与 ParseProjectConfiguration 逐行处理的结果相同
+        void MergeConfigChunk(const ConfigChunk& chunk, SolutionData& data)
+        {
+            std::vector<uint32_t> interned(chunk.strings.size(), StringPool::kNone);
+            std::vector<uint8_t>  listed(chunk.strings.size(), 0);
+            auto                  intern = [&](uint32_t local) {
+                if (interned[local] == StringPool::kNone) {
+                    interned[local] = data.strings.Intern(chunk.strings[local]);
+                }
+                return interned[local];
+            };
+
+            ConfigMappingTable& table = data.configs;
+            for (const ConfigChunk::Line& line : chunk.lines) {
+                if (!listed[line.solutionConfig]) {
+                    listed[line.solutionConfig] = 1;
+                    data.solutionConfigs.emplace(chunk.strings[line.solutionConfig]);
+                }
+                if (line.project == kUnknownProject) {
+                    continue;
+                }
+                uint32_t row = table.Upsert(line.project, intern(line.solutionConfig)).first;
+                ApplyConfigSuffix(line.suffix, line.hasValue, table.flags[row], [&] {
+                    table.buildTypes[row] = intern(line.buildType);
+                    table.platforms[row]  = intern(line.platform);
+                    table.flags[row] |= kMappingActive;
+                });
+            }
+        }
+
+    }  // namespace
+
+    SolutionData ParseSlnText(std::string_view text)
+    {
+        SlnLineParser parser;
+        size_t        lineStart = 0;
+        while (lineStart < text.size()) {
+            auto lineEnd = text.find('\n', lineStart);
+            if (lineEnd == std::string_view::npos) {
+                lineEnd = text.size();
+            }
+            parser.Feed(text.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+        }
+        return parser.Finish();
+    }
+
+    SolutionData ParseSln(const fs::path& slnPath)
+    {
+        std::string pathText = slnPath.string();
+        TraceSpan   span("ParseSln", pathText);
+
+        std::ifstream input(slnPath, std::ios::binary);
+        if (!input) {
+            throw std::runtime_error("无法打开 .sln 文件。");
+        }
+        // 分块读取、逐行解析，峰值内存只与项目数和不同字符串的数量有关，与文件大小无关
+        SlnLineParser     parser;
+        std::vector<char> block(kReadBlockSize);
+        std::string       pending;  // 上一块末尾不完整的行
+        while (input) {
+            size_t got = 0;
+            {
+                TraceSpan readSpan("read");
+                input.read(block.data(), static_cast<std::streamsize>(block.size()));
+                got = static_cast<size_t>(input.gcount());
+            }
+            std::string_view chunk(block.data(), got);
+            size_t           lineStart = 0;
+            for (size_t lineEnd = chunk.find('\n'); lineEnd != std::string_view::npos; lineEnd = chunk.find('\n', lineStart)) {
+                if (pending.empty()) {
+                    parser.Feed(chunk.substr(lineStart, lineEnd - lineStart));
+                } else {
+                    pending.append(chunk.substr(lineStart, lineEnd - lineStart));
+                    parser.Feed(pending);
+                    pending.clear();
+                }
+                lineStart = lineEnd + 1;
+            }
+            pending.append(chunk.substr(lineStart));
+        }
+        if (input.bad()) {
+            throw std::runtime_error("读取 .sln 文件失败。");
+        }
+        parser.Feed(pending);
+        return parser.Finish();
+    }
+
+    LazySln::LazySln(const fs::path& slnPath)
+    {
+        std::string pathText = slnPath.string();
+        TraceSpan   span("LazySln", pathText);
+
+        std::ifstream input(slnPath, std::ios::binary);
+        if (!input) {
+            throw std::runtime_error("无法打开 .sln 文件。");
+        }
+        {
+            TraceSpan readSpan("read");
+            input.seekg(0, std::ios::end);
+            m_text.resize(static_cast<size_t>(input.tellg()));
+            input.seekg(0, std::ios::beg);
+            input.read(m_text.data(), static_cast<std::streamsize>(m_text.size()));
+        }
+        if (!input) {
+            throw std::runtime_error("读取 .sln 文件失败。");
+        }
+        Scan();
+    }
+
+    LazySln::LazySln(std::string text)
+        : m_text(std::move(text))
+    {
+        Scan();
+    }
+
+    void LazySln::Scan()
+    {
+        TraceSpan span("LazySln/Scan");
+
+        // 与 SlnLineParser 相同的结构状态机，只是区段内的行不解析；
+        // 区段中途出现的项目头会把区段切开，保证按需解析与逐行解析的结果一致
+        bool   inProject = false;
+        bool   inSection = false;
+        size_t next      = 0;
+        while (next < m_text.size()) {
+            size_t lineStart = next;
+            size_t lineEnd   = m_text.find('\n', lineStart);
+            if (lineEnd == std::string::npos) {
+                lineEnd = m_text.size();
+            }
+            next = std::min(lineEnd + 1, m_text.size());
+
+            // 结构行都以 P、G、E 开头；区段内绝大多数行是以 { 开头的映射，看首字符即可跳过
+            size_t first = lineStart;
+            while (first < lineEnd && std::isspace(static_cast<unsigned char>(m_text[first]))) {
+                ++first;
+            }
+            if (first == lineEnd || (m_text[first] != 'P' && m_text[first] != 'G' && m_text[first] != 'E')) {
+                continue;
+            }
+            std::string_view trimmed = TrimView(std::string_view(m_text).substr(first, lineEnd - first));
+            if (inProject) {
+                if (StartsWith(trimmed, "EndProject") && !StartsWith(trimmed, "EndProjectSection")) {
+                    m_projectBodies.back().end = lineStart;
+                    inProject                  = false;
+                    if (inSection) {
+                        m_globalSections.push_back(ContinueSection(m_globalSections.back(), next));
+                    }
+                }
+            } else if (StartsWith(trimmed, "Project(")) {
+                if (inSection) {
+                    m_globalSections.back().body.end = lineStart;
+                }
+                inProject = AddProjectHeader(std::string(trimmed), m_data);
+                if (inProject) {
+                    m_projectBodies.push_back({ next, next });
+                } else if (inSection) {
+                    m_globalSections.push_back(ContinueSection(m_globalSections.back(), next));
+                }
+            } else if (StartsWith(trimmed, "GlobalSection(")) {
+                if (inSection) {
+                    m_globalSections.back().body.end = lineStart;
+                }
+                PropertySection   header = ParseSectionHeader(trimmed);
+                GlobalSectionKind kind   = ResolveGlobalSection(header.name);
+                m_globalSections.push_back({ kind, std::move(header), false, { next, next } });
+                inSection = true;
+            } else if (StartsWith(trimmed, "EndGlobalSection")) {
+                if (inSection) {
+                    m_globalSections.back().body.end = lineStart;
+                }
+                inSection = false;
+            }
+        }
+        // 文件在区段或项目体中途结束时，范围延伸到末尾
+        if (inProject) {
+            m_projectBodies.back().end = m_text.size();
+        } else if (inSection) {
+            m_globalSections.back().body.end = m_text.size();
+        }
+    }
+
+    template <typename Fn>
+    void LazySln::ForEachLine(Range range, Fn&& fn) const
+    {
+        std::string_view body      = std::string_view(m_text).substr(range.begin, range.end - range.begin);
+        size_t           lineStart = 0;
+        while (lineStart < body.size()) {
+            size_t lineEnd = body.find('\n', lineStart);
+            if (lineEnd == std::string_view::npos) {
+                lineEnd = body.size();
+            }
+            std::string trimmed = Trim(body.substr(lineStart, lineEnd - lineStart));
+            if (!trimmed.empty()) {
+                fn(trimmed);
+            }
+            lineStart = lineEnd + 1;
+        }
+    }
+
+    LazySln::GlobalSectionRange LazySln::ContinueSection(const GlobalSectionRange& section, size_t next)
+    {
+        return { section.kind, section.header, true, { next, next } };
+    }
+
+    void LazySln::FeedGlobalSections(std::initializer_list<GlobalSectionKind> kinds, const RangeRunner& runRanges)
+    {
+        for (const auto& section : m_globalSections) {
+            if (std::find(kinds.begin(), kinds.end(), section.kind) == kinds.end()) {
+                continue;
+            }
+            if (section.kind == GlobalSectionKind::ProjectConfigurationPlatforms && runRanges
+                && section.body.end - section.body.begin > kConfigChunkSize) {
+                FeedProjectConfigurations(section.body, runRanges);
+                continue;
+            }
+            if (section.kind == GlobalSectionKind::Properties && !section.continued) {
+                m_data.properties.push_back(section.header);
+            }
+            const GlobalSectionHandler& handler = HandlerFor(section.kind);
+            ForEachLine(section.body, [&](const std::string& line) { handler.feedLine(line, m_data); });
+        }
+    }
+
+    void LazySln::FeedProjectConfigurations(Range body, const RangeRunner& runRanges)
+    {
+        std::vector<Range> ranges;
+        for (size_t begin = body.begin; begin < body.end;) {
+            size_t end = begin + kConfigChunkSize < body.end ? m_text.find('\n', begin + kConfigChunkSize) : std::string::npos;
+            end        = end == std::string::npos || end >= body.end ? body.end : end + 1;
+            ranges.push_back({ begin, end });
+            begin = end;
+        }
+
+        // 各块只读 GUID 索引，互不干扰；驻留字符串与写入映射表留给合并阶段按顺序进行
+        std::vector<ConfigChunk> chunks(ranges.size());
+        runRanges(ranges.size(), [&](size_t first, size_t last) {
+            for (size_t index = first; index < last; ++index) {
+                Range range = ranges[index];
+                ParseConfigChunk(std::string_view(m_text).substr(range.begin, range.end - range.begin), m_data, chunks[index]);
+            }
+        });
+
+        TraceSpan span("ParseSln/MergeConfigChunks");
+        for (ConfigChunk& chunk : chunks) {
+            MergeConfigChunk(chunk, m_data);
+            chunk = ConfigChunk();
+        }
+    }
+
+    const SolutionData& LazySln::Nesting()
+    {
+        if (!m_nestingParsed) {
+            TraceSpan span("LazySln/NestedProjects");
+            FeedGlobalSections({ GlobalSectionKind::NestedProjects });
+            m_nestingParsed = true;
+        }
+        return m_data;
+    }
+
+    const SolutionData& LazySln::ProjectSections()
+    {
+        if (!m_projectSectionsParsed) {
+            TraceSpan span("LazySln/ProjectSections");
+            for (size_t index = 0; index < m_projectBodies.size(); ++index) {
+                ProjectBodyState state;
+                ForEachLine(m_projectBodies[index], [&](const std::string& line) {
+                    FeedProjectBodyLine(line, m_data.projects[index], state);
+                });
+            }
+            m_projectSectionsParsed = true;
+        }
+        return m_data;
+    }
+
+    const SolutionData& LazySln::Configurations(const RangeRunner& runRanges)
+    {
+        if (!m_configurationsParsed) {
+            TraceSpan span("LazySln/Configurations");
+            // 两个区段都会驻留配置名，按文件顺序解析，字符串 id 与逐行解析时相同
+            FeedGlobalSections(
+                { GlobalSectionKind::SolutionConfigurationPlatforms, GlobalSectionKind::ProjectConfigurationPlatforms }, runRanges);
+            m_data.configs.Seal(m_data.projects.size());
+            m_configurationsParsed = true;
+        }
+        return m_data;
+    }
+
+    SolutionData LazySln::Materialize(const RangeRunner& runRanges) &&
+    {
+        Nesting();
+        ProjectSections();
+        Configurations(runRanges);
+        FeedGlobalSections({ GlobalSectionKind::Properties });
+        return std::move(m_data);
+    }
+
+}  // namespace gotoslnx
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "solution.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // GlobalSection 的种类，在区段头处解析一次，区段内各行按种类查表分派
+    enum class GlobalSectionKind : uint8_t
+    {
+        SolutionConfigurationPlatforms,
+        ProjectConfigurationPlatforms,
+        NestedProjects,
+        Properties,  // 其余命名区段，按键值对保留到 SolutionData::properties
+        Ignored,     // 缺少名称
+    };
+
+    std::string                         Trim(std::string_view input);
+    bool                                StartsWith(std::string_view text, std::string_view prefix);
+    bool                                EqualsIgnoreCase(std::string_view left, std::string_view right);
+    std::vector<std::string>            SplitOnce(std::string_view text, char delimiter);
+    std::pair<std::string, std::string> SplitConfig(const std::string& config);
+
+    std::optional<ProjectEntry> ParseProjectHeader(const std::string& line);
+    void                        ParseSolutionConfiguration(const std::string& line, SolutionData& data);
+    void                        ParseProjectConfiguration(const std::string& line, SolutionData& data);
+    void                        ParseNestedProject(const std::string& line, SolutionData& data);
+
+    std::string NormalizeFolderPath(const std::vector<std::string>& segments);
+    std::string ResolveFolderPath(const std::string& folderGuid, const SolutionData& data,
+        std::unordered_map<std::string, std::string>& cache, std::unordered_map<std::string, bool>& visiting);
+    std::string NormalizeGuidForSlnx(std::string_view guid);
+
+    SolutionData ParseSlnText(std::string_view text);
+    SolutionData ParseSln(const std::filesystem::path& slnPath);
+
+    // 按需解析的 .sln：构造时只做一遍结构扫描，项目头立即解析，ProjectSection 与 GlobalSection 只记录字节范围，
+    // 首次访问对应数据时才解析。只需项目列表或文件夹树的查询可以跳过体积最大的 ProjectConfigurationPlatforms
+    class LazySln
+    {
+    public:
+        explicit LazySln(const std::filesystem::path& slnPath);
+        explicit LazySln(std::string text);
+
+        // 项目头（名称、路径、GUID、类型）与 GUID 索引
+        const SolutionData& Projects() const { return m_data; }
+        // 以下各自补全一部分数据后返回同一个对象
+        const SolutionData& Nesting();          // NestedProjects
+        const SolutionData& ProjectSections();  // 项目依赖与解决方案项
+        // 解决方案配置与项目配置映射，映射表已 Seal。给出 runRanges 时，较大的 ProjectConfigurationPlatforms
+        // 按行对齐切块并行解析，再按文件顺序合并，结果与逐行解析相同
+        const SolutionData& Configurations(const RangeRunner& runRanges = {});
+        // 解析其余全部区段。结果与 ParseSlnText 相同，只有项目头写在 Global 之后的非常规文件例外：
+        // 这里的配置映射也能关联到这些项目
+        SolutionData Materialize(const RangeRunner& runRanges = {}) &&;
+
+    private:
+        struct Range
+        {
+            size_t begin = 0;
+            size_t end   = 0;
+        };
+
+        struct GlobalSectionRange
+        {
+            GlobalSectionKind kind;
+            PropertySection   header;     // 区段名与 pre/post，条目为空
+            bool              continued;  // 被项目头隔开后的后续片段
+            Range             body;
+        };
+
+        static GlobalSectionRange ContinueSection(const GlobalSectionRange& section, size_t next);
+
+        void Scan();
+        template <typename Fn>
+        void ForEachLine(Range range, Fn&& fn) const;
+        void FeedGlobalSections(std::initializer_list<GlobalSectionKind> kinds, const RangeRunner& runRanges = {});
+        void FeedProjectConfigurations(Range body, const RangeRunner& runRanges);
+
+        std::string                     m_text;
+        SolutionData                    m_data;
+        std::vector<Range>              m_projectBodies;   // 与 m_data.projects 一一对应
+        std::vector<GlobalSectionRange> m_globalSections;  // 按文件顺序，同一区段可能被项目头隔成几段
+        bool                            m_nestingParsed         = false;
+        bool                            m_projectSectionsParsed = false;
+        bool                            m_configurationsParsed  = false;
+    };
+
+}  // namespace gotoslnx
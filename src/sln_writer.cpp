@@ -0,0 +1,197 @@
+#include "sln_writer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        constexpr std::string_view kNewLine = "\r\n";
+
+        class SlnBuffer
+        {
+        public:
+            explicit SlnBuffer(size_t reserve) { m_text.reserve(reserve); }
+
+            template <typename... Parts>
+            void Line(size_t indent, const Parts&... parts)
+            {
+                m_text.append(indent, '\t');
+                (m_text.append(parts), ...);
+                m_text.append(kNewLine);
+            }
+
+            std::string Take() { return std::move(m_text); }
+
+        private:
+            std::string m_text;
+        };
+
+        std::string ToSlnPath(std::string_view path)
+        {
+            std::string output(path);
+            for (auto& ch : output) {
+                if (ch == '/') {
+                    ch = '\\';
+                }
+            }
+            return output;
+        }
+
+        void WritePropertySection(SlnBuffer& out, size_t indent, std::string_view kind, const PropertySection& section,
+            std::string_view scope)
+        {
+            if (section.name.empty()) {
+                return;
+            }
+            out.Line(indent, kind, "Section(", section.name, ") = ", section.postLoad ? "post" : "pre", scope);
+            // SharedMSBuildProjectFiles 的键以路径开头（"路径*{项目 GUID}*SharedItemsImports"），与项目路径一样写成反斜杠
+            bool sharedFiles = section.name == "SharedMSBuildProjectFiles";
+            for (const auto& [key, value] : section.entries) {
+                out.Line(indent + 1, sharedFiles ? ToSlnPath(key) : key, " = ", value);
+            }
+            out.Line(indent, "End", kind, "Section");
+        }
+
+        size_t EstimateSize(const SolutionData& data)
+        {
+            size_t size = 512;
+            for (const auto& project : data.projects) {
+                size += 160 + project.name.size() + project.path.size();
+                size += project.dependencies.size() * 90;
+                size += project.solutionItems.size() * 64;
+                for (const auto& section : project.properties) {
+                    size += 64 + section.entries.size() * 96;
+                }
+            }
+            for (const auto& section : data.properties) {
+                size += 64 + section.entries.size() * 96;
+            }
+            size += data.configs.Size() * 200;
+            return size;
+        }
+
+    }  // namespace
+
+    std::string FormatSln(const SolutionData& data)
+    {
+        SlnBuffer out(EstimateSize(data));
+        out.Line(0, "\xEF\xBB\xBF");
+        out.Line(0, "Microsoft Visual Studio Solution File, Format Version 12.00");
+        out.Line(0, "# Visual Studio Version 17");
+        out.Line(0, "VisualStudioVersion = 17.0.31903.59");
+        out.Line(0, "MinimumVisualStudioVersion = 10.0.40219.1");
+
+        for (const auto& project : data.projects) {
+            std::string path = project.isSolutionFolder ? project.name : ToSlnPath(project.path);
+            out.Line(0, "Project(\"", project.typeGuid, "\") = \"", project.name, "\", \"", path, "\", \"", project.guid, "\"");
+            if (!project.solutionItems.empty()) {
+                out.Line(1, "ProjectSection(SolutionItems) = preProject");
+                for (const auto& item : project.solutionItems) {
+                    std::string itemPath = ToSlnPath(item);
+                    out.Line(2, itemPath, " = ", itemPath);
+                }
+                out.Line(1, "EndProjectSection");
+            }
+            if (!project.dependencies.empty()) {
+                out.Line(1, "ProjectSection(ProjectDependencies) = postProject");
+                for (const auto& dep : project.dependencies) {
+                    out.Line(2, dep, " = ", dep);
+                }
+                out.Line(1, "EndProjectSection");
+            }
+            for (const auto& section : project.properties) {
+                WritePropertySection(out, 1, "Project", section, "Project");
+            }
+            out.Line(0, "EndProject");
+        }
+
+        out.Line(0, "Global");
+        if (!data.solutionConfigs.empty()) {
+            out.Line(1, "GlobalSection(SolutionConfigurationPlatforms) = preSolution");
+            for (const auto& config : data.solutionConfigs) {
+                out.Line(2, config, " = ", config);
+            }
+            out.Line(1, "EndGlobalSection");
+
+            out.Line(1, "GlobalSection(ProjectConfigurationPlatforms) = postSolution");
+            for (size_t index = 0; index < data.projects.size(); ++index) {
+                const ProjectEntry& project = data.projects[index];
+                if (project.isSolutionFolder) {
+                    continue;
+                }
+                for (const auto& config : data.solutionConfigs) {
+                    auto mapping = FindConfigMapping(data, index, config);
+                    if (!mapping || !mapping->Has(kMappingActive)) {
+                        continue;
+                    }
+                    std::string_view buildType = data.strings.View(mapping->projectBuildType);
+                    std::string_view platform  = data.strings.View(mapping->projectPlatform);
+                    out.Line(2, project.guid, ".", config, ".ActiveCfg = ", buildType, "|", platform);
+                    if (mapping->Has(kMappingBuild)) {
+                        out.Line(2, project.guid, ".", config, ".Build.0 = ", buildType, "|", platform);
+                    }
+                    if (mapping->Has(kMappingDeploy)) {
+                        out.Line(2, project.guid, ".", config, ".Deploy.0 = ", buildType, "|", platform);
+                    }
+                }
+            }
+            out.Line(1, "EndGlobalSection");
+        }
+
+        // SolutionProperties 总是写出，缺少 HideSolutionNode 时补上缺省值；同名区段合并为一个
+        PropertySection solutionProperties { std::string(kSolutionPropertiesSection), false, {} };
+        for (const auto& section : data.properties) {
+            if (section.name == kSolutionPropertiesSection) {
+                solutionProperties.entries.insert(solutionProperties.entries.end(), section.entries.begin(), section.entries.end());
+            }
+        }
+        auto hideSolutionNode = std::find_if(solutionProperties.entries.begin(), solutionProperties.entries.end(),
+            [](const auto& entry) { return entry.first == "HideSolutionNode"; });
+        if (hideSolutionNode == solutionProperties.entries.end()) {
+            solutionProperties.entries.insert(solutionProperties.entries.begin(), { "HideSolutionNode", "FALSE" });
+        }
+        WritePropertySection(out, 1, "Global", solutionProperties, "Solution");
+
+        bool hasNested = false;
+        for (const auto& project : data.projects) {
+            auto parent = data.nestedProjects.find(project.guid);
+            if (parent == data.nestedProjects.end()) {
+                continue;
+            }
+            if (!hasNested) {
+                out.Line(1, "GlobalSection(NestedProjects) = preSolution");
+                hasNested = true;
+            }
+            out.Line(2, project.guid, " = ", parent->second);
+        }
+        if (hasNested) {
+            out.Line(1, "EndGlobalSection");
+        }
+        for (const auto& section : data.properties) {
+            if (section.name != kSolutionPropertiesSection) {
+                WritePropertySection(out, 1, "Global", section, "Solution");
+            }
+        }
+        out.Line(0, "EndGlobal");
+        return out.Take();
+    }
+
+    void WriteSln(const fs::path& outputPath, const SolutionData& data)
+    {
+        std::string text = FormatSln(data);
+
+        std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+        output.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (!output) {
+            throw std::runtime_error("写入 .sln 文件失败。");
+        }
+    }
+
+}  // namespace gotoslnx
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "solution.h"
+
+#include <filesystem>
+#include <string>
+
+namespace gotoslnx
+{
+
+    std::string FormatSln(const SolutionData& data);
+    void        WriteSln(const std::filesystem::path& outputPath, const SolutionData& data);
+
+}  // namespace gotoslnx
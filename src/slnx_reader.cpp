@@ -0,0 +1,415 @@
+#include "slnx_reader.h"
+#include "guid_util.h"
+#include "project_types.h"
+#include "sln_parser.h"
+#include "xml_reader.h"
+
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        enum class RuleDimension
+        {
+            BuildType,
+            Platform,
+            Build,
+            Deploy,
+        };
+
+        struct ConfigRule
+        {
+            RuleDimension dimension;
+            std::string   solutionBuildType;
+            std::string   solutionPlatform;
+            std::string   value;
+        };
+
+        struct PendingProject
+        {
+            size_t                   index = 0;
+            std::vector<std::string> dependencyPaths;
+            std::vector<ConfigRule>  rules;
+            bool                     inProperties = false;  // 最近一个子元素是 Properties
+        };
+
+        std::string PathKey(std::string_view path)
+        {
+            std::string key;
+            key.reserve(path.size());
+            for (unsigned char ch : path) {
+                key.push_back(ch == '\\' ? '/' : static_cast<char>(std::tolower(ch)));
+            }
+            return key;
+        }
+
+        std::string ProjectNameFromPath(std::string_view path)
+        {
+            auto slash = path.find_last_of("/\\");
+            if (slash != std::string_view::npos) {
+                path = path.substr(slash + 1);
+            }
+            auto dot = path.rfind('.');
+            if (dot != std::string_view::npos && dot > 0) {
+                path = path.substr(0, dot);
+            }
+            return std::string(path);
+        }
+
+        bool ParseBoolAttribute(const std::optional<std::string>& value)
+        {
+            return !value || !EqualsIgnoreCase(*value, "false");
+        }
+
+        PropertySection ReadPropertiesHeader(const XmlReader& reader)
+        {
+            PropertySection section;
+            section.name     = reader.Attribute("Name").value_or(std::string());
+            section.postLoad = EqualsIgnoreCase(reader.Attribute("Scope").value_or(std::string()), "PostLoad");
+            return section;
+        }
+
+        void AddProperty(const XmlReader& reader, PropertySection& section)
+        {
+            auto name = reader.Attribute("Name");
+            if (name && !name->empty()) {
+                section.entries.emplace_back(*name, reader.Attribute("Value").value_or(std::string()));
+            }
+        }
+
+        class SlnxBuilder
+        {
+        public:
+            explicit SlnxBuilder(SolutionData& data) : m_data(data) {}
+
+            size_t EnsureFolder(std::string_view folderPath, const std::optional<std::string>& id)
+            {
+                std::vector<std::string> segments;
+                size_t                   start = 0;
+                while (start < folderPath.size()) {
+                    auto slash = folderPath.find('/', start);
+                    if (slash == std::string_view::npos) {
+                        slash = folderPath.size();
+                    }
+                    if (slash > start) {
+                        segments.emplace_back(folderPath.substr(start, slash - start));
+                    }
+                    start = slash + 1;
+                }
+                if (segments.empty()) {
+                    throw std::runtime_error(fmt::format("无效的文件夹名称: {}", folderPath));
+                }
+
+                std::string key    = "/";
+                size_t      index  = 0;
+                std::string parent;
+                for (size_t i = 0; i < segments.size(); ++i) {
+                    key += segments[i];
+                    key += '/';
+                    auto found = m_folderIndex.find(key);
+                    if (found != m_folderIndex.end()) {
+                        index  = found->second;
+                        parent = m_data.projects[index].guid;
+                        continue;
+                    }
+
+                    ProjectEntry folder;
+                    folder.typeGuid         = std::string(kSolutionFolderTypeGuid);
+                    folder.name             = segments[i];
+                    folder.path             = segments[i];
+                    folder.guid             = i + 1 == segments.size() && id ? FormatGuidForSln(*id)
+                                                                             : MakeDeterministicGuid("folder:" + key);
+                    folder.kind             = ProjectKind::SolutionFolder;
+                    folder.isSolutionFolder = true;
+
+                    index = m_data.projects.size();
+                    m_folderIndex.emplace(key, index);
+                    m_data.guidToName[folder.guid]  = folder.name;
+                    m_data.guidToIndex[folder.guid] = index;
+                    if (!parent.empty()) {
+                        m_data.nestedProjects[folder.guid] = parent;
+                    }
+                    parent = folder.guid;
+                    m_data.projects.push_back(std::move(folder));
+                }
+                return index;
+            }
+
+            void AddProject(const XmlReader& reader, std::optional<size_t> folder)
+            {
+                auto path = reader.Attribute("Path");
+                if (!path || path->empty()) {
+                    throw std::runtime_error(fmt::format("第 {} 行的 Project 缺少 Path 属性。", reader.Line()));
+                }
+                auto id          = reader.Attribute("Id");
+                auto displayName = reader.Attribute("DisplayName");
+
+                ProjectEntry project;
+                project.typeGuid = ProjectTypeGuidForSlnx(*path, reader.Attribute("Type").value_or(std::string()));
+                project.name     = displayName ? *displayName : ProjectNameFromPath(*path);
+                project.path     = *path;
+                project.guid     = id ? FormatGuidForSln(*id) : MakeDeterministicGuid(PathKey(*path));
+                project.kind     = ClassifyProjectType(project.typeGuid);
+
+                m_data.guidToName[project.guid]  = project.name;
+                m_data.guidToPath[project.guid]  = project.path;
+                m_data.guidToIndex[project.guid] = m_data.projects.size();
+                if (folder) {
+                    m_data.nestedProjects[project.guid] = m_data.projects[*folder].guid;
+                }
+                m_projectGuidByPath.emplace(PathKey(project.path), project.guid);
+
+                m_pending.push_back({ m_data.projects.size(), {}, {}, false });
+                m_data.projects.push_back(std::move(project));
+            }
+
+            void AddProjectChild(const XmlReader& reader)
+            {
+                PendingProject&  pending = m_pending.back();
+                std::string_view name    = reader.Name();
+                pending.inProperties     = name == "Properties";
+                if (pending.inProperties) {
+                    m_data.projects[pending.index].properties.push_back(ReadPropertiesHeader(reader));
+                    return;
+                }
+                if (name == "BuildDependency") {
+                    auto dep = reader.Attribute("Project");
+                    if (dep && !dep->empty()) {
+                        pending.dependencyPaths.push_back(*dep);
+                    }
+                    return;
+                }
+
+                RuleDimension dimension;
+                if (name == "BuildType") {
+                    dimension = RuleDimension::BuildType;
+                } else if (name == "Platform") {
+                    dimension = RuleDimension::Platform;
+                } else if (name == "Build") {
+                    dimension = RuleDimension::Build;
+                } else if (name == "Deploy") {
+                    dimension = RuleDimension::Deploy;
+                } else {
+                    return;
+                }
+
+                ConfigRule rule;
+                rule.dimension                = dimension;
+                std::string solution          = reader.Attribute("Solution").value_or("*|*");
+                auto [buildType, platform]    = SplitConfig(solution);
+                rule.solutionBuildType        = buildType.empty() ? "*" : buildType;
+                rule.solutionPlatform         = platform.empty() ? "*" : platform;
+                auto value                    = reader.Attribute("Project");
+                if (dimension == RuleDimension::Build || dimension == RuleDimension::Deploy) {
+                    rule.value = ParseBoolAttribute(value) ? "true" : "false";
+                } else if (value) {
+                    rule.value = *value;
+                } else {
+                    return;
+                }
+                pending.rules.push_back(std::move(rule));
+            }
+
+            void AddProjectProperty(const XmlReader& reader)
+            {
+                const PendingProject& pending = m_pending.back();
+                if (pending.inProperties && reader.Name() == "Property") {
+                    AddProperty(reader, m_data.projects[pending.index].properties.back());
+                }
+            }
+
+            void AddSolutionItem(const XmlReader& reader, size_t folder)
+            {
+                auto path = reader.Attribute("Path");
+                if (path && !path->empty()) {
+                    m_data.projects[folder].solutionItems.push_back(*path);
+                }
+            }
+
+            void Finish()
+            {
+                if (m_data.buildTypes.empty()) {
+                    m_data.buildTypes = { "Debug", "Release" };
+                }
+                if (m_data.platforms.empty()) {
+                    m_data.platforms = { "Any CPU" };
+                }
+                for (const auto& buildType : m_data.buildTypes) {
+                    for (const auto& platform : m_data.platforms) {
+                        m_data.solutionConfigs.insert(buildType + "|" + platform);
+                    }
+                }
+
+                for (const auto& pending : m_pending) {
+                    ProjectEntry& project = m_data.projects[pending.index];
+                    for (const auto& depPath : pending.dependencyPaths) {
+                        auto found = m_projectGuidByPath.find(PathKey(depPath));
+                        if (found != m_projectGuidByPath.end()) {
+                            project.dependencies.push_back(found->second);
+                        }
+                    }
+                    if (!HasConfigurations(project.kind)) {
+                        continue;
+                    }
+                    for (const auto& buildType : m_data.buildTypes) {
+                        for (const auto& platform : m_data.platforms) {
+                            std::string_view projectBuildType = buildType;
+                            std::string_view projectPlatform  = platform;
+                            bool             build            = true;
+                            bool             deploy           = false;
+                            for (const auto& rule : pending.rules) {
+                                if ((rule.solutionBuildType != "*" && rule.solutionBuildType != buildType)
+                                    || (rule.solutionPlatform != "*" && rule.solutionPlatform != platform)) {
+                                    continue;
+                                }
+                                switch (rule.dimension) {
+                                    case RuleDimension::BuildType:
+                                        projectBuildType = rule.value;
+                                        break;
+                                    case RuleDimension::Platform:
+                                        projectPlatform = rule.value;
+                                        break;
+                                    case RuleDimension::Build:
+                                        build = rule.value == "true";
+                                        break;
+                                    case RuleDimension::Deploy:
+                                        deploy = rule.value == "true";
+                                        break;
+                                }
+                            }
+                            ConfigMappingTable& table    = m_data.configs;
+                            uint32_t            configId = m_data.strings.Intern(buildType + "|" + platform);
+                            uint32_t            row      = table.Upsert(static_cast<uint32_t>(pending.index), configId).first;
+                            table.buildTypes[row]        = m_data.strings.Intern(projectBuildType);
+                            table.platforms[row]         = m_data.strings.Intern(projectPlatform);
+                            table.flags[row]             = kMappingActive | (build ? kMappingBuild : 0) | (deploy ? kMappingDeploy : 0);
+                        }
+                    }
+                }
+                m_data.configs.Seal(m_data.projects.size());
+            }
+
+        private:
+            SolutionData&                                m_data;
+            std::unordered_map<std::string, size_t>      m_folderIndex;
+            std::unordered_map<std::string, std::string> m_projectGuidByPath;
+            std::vector<PendingProject>                  m_pending;
+        };
+
+    }  // namespace
+
+    SolutionData ParseSlnxText(std::string_view text)
+    {
+        SolutionData data;
+        SlnxBuilder  builder(data);
+        XmlReader    reader(text);
+
+        bool                  sawRoot          = false;
+        bool                  inConfigurations = false;
+        bool                  inProperties     = false;
+        std::optional<size_t> currentFolder;
+        size_t                projectDepth = 0;
+
+        while (reader.Read()) {
+            std::string_view name  = reader.Name();
+            size_t           depth = reader.Depth();
+
+            if (reader.Type() == XmlReader::NodeType::EndElement) {
+                if (projectDepth != 0 && depth + 1 == projectDepth && name == "Project") {
+                    projectDepth = 0;
+                } else if (name == "Folder" && depth == 1) {
+                    currentFolder.reset();
+                } else if (name == "Configurations" && depth == 1) {
+                    inConfigurations = false;
+                } else if (name == "Properties" && depth == 1) {
+                    inProperties = false;
+                }
+                continue;
+            }
+
+            if (depth == 1) {
+                if (name != "Solution") {
+                    throw std::runtime_error(fmt::format("根元素应为 Solution，实际为 {}。", name));
+                }
+                sawRoot = true;
+                continue;
+            }
+
+            if (projectDepth != 0) {
+                if (depth == projectDepth + 1) {
+                    builder.AddProjectChild(reader);
+                } else if (depth == projectDepth + 2) {
+                    builder.AddProjectProperty(reader);
+                }
+                continue;
+            }
+
+            if (inConfigurations) {
+                auto value = reader.Attribute("Name");
+                if (depth == 3 && value && !value->empty()) {
+                    if (name == "BuildType") {
+                        data.buildTypes.insert(*value);
+                    } else if (name == "Platform") {
+                        data.platforms.insert(*value);
+                    }
+                }
+                continue;
+            }
+
+            if (inProperties) {
+                if (depth == 3 && name == "Property") {
+                    AddProperty(reader, data.properties.back());
+                }
+                continue;
+            }
+
+            if (depth == 2 && name == "Configurations") {
+                inConfigurations = true;
+            } else if (depth == 2 && name == "Properties") {
+                PropertySection& section = data.properties.emplace_back(ReadPropertiesHeader(reader));
+                if (section.name == kSlnxSolutionProperties) {
+                    section.name = kSolutionPropertiesSection;
+                }
+                inProperties = true;
+            } else if (depth == 2 && name == "Folder") {
+                auto folderName = reader.Attribute("Name");
+                if (!folderName) {
+                    throw std::runtime_error(fmt::format("第 {} 行的 Folder 缺少 Name 属性。", reader.Line()));
+                }
+                currentFolder = builder.EnsureFolder(*folderName, reader.Attribute("Id"));
+            } else if (name == "Project" && (depth == 2 || (depth == 3 && currentFolder))) {
+                builder.AddProject(reader, depth == 3 ? currentFolder : std::nullopt);
+                projectDepth = depth;
+            } else if (name == "File" && depth == 3 && currentFolder) {
+                builder.AddSolutionItem(reader, *currentFolder);
+            }
+        }
+
+        if (!sawRoot) {
+            throw std::runtime_error("未找到 Solution 根元素。");
+        }
+        builder.Finish();
+        return data;
+    }
+
+    SolutionData ReadSlnx(const fs::path& slnxPath)
+    {
+        std::ifstream input(slnxPath, std::ios::binary);
+        if (!input) {
+            throw std::runtime_error("无法打开 .slnx 文件。");
+        }
+        std::string text((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        return ParseSlnxText(text);
+    }
+
+}  // namespace gotoslnx
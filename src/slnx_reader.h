@@ -0,0 +1,14 @@
+#pragma once
+
+#include "solution.h"
+
+#include <filesystem>
+#include <string_view>
+
+namespace gotoslnx
+{
+
+    SolutionData ParseSlnxText(std::string_view text);
+    SolutionData ReadSlnx(const std::filesystem::path& slnxPath);
+
+}  // namespace gotoslnx
@@ -0,0 +1,494 @@
+#include "slnx_writer.h"
+#include "canonical_order.h"
+#include "gather_write.h"
+#include "sln_parser.h"
+#include "trace.h"
+#include "xml_writer.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        struct ConfigGrid
+        {
+            std::vector<const std::string*> buildTypes;
+            std::vector<const std::string*> platforms;
+            std::vector<uint32_t>           slotOfCell;  // 网格下标 -> 映射表槽位，不是解决方案配置的为 kNoRow
+            std::vector<uint32_t>           cellOfSlot;  // 槽位 -> 网格下标，不在网格中的为 kNoRow
+            std::vector<ConfigBits>         rowMasks;
+            std::vector<ConfigBits>         colMasks;
+            bool                            identity = false;  // 网格与槽位一一对应且顺序一致
+
+            size_t Size() const { return buildTypes.size() * platforms.size(); }
+        };
+
+        struct ConfigRule
+        {
+            const char* dimension = nullptr;
+            std::string solution;  // 空表示 "*|*"
+            std::string value;
+            bool        hasValue = false;
+        };
+
+        // 规范模式下文件夹与项目路径的驻留表及其字节序排名
+        struct CanonicalPaths
+        {
+            StringPool            pool;
+            std::vector<uint32_t> rank;
+
+            uint32_t Rank(std::string_view path) const { return rank[pool.Find(path)]; }
+        };
+
+        void AppendBuildTypesAndPlatforms(XmlWriter& xml, const SolutionData& data)
+        {
+            if (data.buildTypes.empty() && data.platforms.empty()) {
+                return;
+            }
+
+            xml.OpenElement("Configurations");
+            for (const auto& buildType : data.buildTypes) {
+                xml.OpenElement("BuildType");
+                xml.Attribute("Name", buildType);
+                xml.CloseElement();
+            }
+            for (const auto& platform : data.platforms) {
+                xml.OpenElement("Platform");
+                xml.Attribute("Name", platform);
+                xml.CloseElement();
+            }
+            xml.CloseElement();
+        }
+
+        // 写出时省略的条目：HideSolutionNode = FALSE 是缺省值，SolutionGuid 在 slnx 中没有对应的位置
+        bool IsImplicitProperty(std::string_view section, const std::pair<std::string, std::string>& entry)
+        {
+            if (section == kSolutionPropertiesSection) {
+                return entry.first == "HideSolutionNode" && EqualsIgnoreCase(entry.second, "FALSE");
+            }
+            if (section == "ExtensibilityGlobals") {
+                return entry.first == "SolutionGuid";
+            }
+            return false;
+        }
+
+        void AppendPropertiesXml(XmlWriter& xml, const std::vector<PropertySection>& sections)
+        {
+            for (const auto& section : sections) {
+                bool opened = false;
+                for (const auto& entry : section.entries) {
+                    if (IsImplicitProperty(section.name, entry)) {
+                        continue;
+                    }
+                    if (!opened) {
+                        xml.OpenElement("Properties");
+                        xml.Attribute("Name", section.name == kSolutionPropertiesSection ? kSlnxSolutionProperties : section.name);
+                        if (section.postLoad) {
+                            xml.Attribute("Scope", "PostLoad");
+                        }
+                        opened = true;
+                    }
+                    xml.OpenElement("Property");
+                    xml.Attribute("Name", entry.first);
+                    xml.Attribute("Value", entry.second);
+                    xml.CloseElement();
+                }
+                if (opened) {
+                    xml.CloseElement();
+                }
+            }
+        }
+
+        // 用尽量少的 "*|*"、"BuildType|*"、"*|Platform" 模式覆盖选中的解决方案配置
+        std::vector<std::string> CoverSolutionConfigs(const ConfigBits& selected, const ConfigGrid& grid)
+        {
+            const size_t rows = grid.buildTypes.size();
+            const size_t cols = grid.platforms.size();
+
+            std::vector<std::string> patterns;
+            if (selected.All()) {
+                patterns.emplace_back("*|*");
+                return patterns;
+            }
+
+            ConfigBits covered(selected.Size());
+            for (size_t row = 0; row < rows && cols > 1; ++row) {
+                if (selected.Covers(grid.rowMasks[row])) {
+                    patterns.push_back(*grid.buildTypes[row] + "|*");
+                    covered |= grid.rowMasks[row];
+                }
+            }
+            for (size_t col = 0; col < cols && rows > 1; ++col) {
+                if (selected.Covers(grid.colMasks[col]) && !covered.Covers(grid.colMasks[col])) {
+                    patterns.push_back("*|" + *grid.platforms[col]);
+                    covered |= grid.colMasks[col];
+                }
+            }
+            ConfigBits remaining = ~covered;
+            remaining &= selected;
+            remaining.ForEach([&](size_t index) {
+                patterns.push_back(*grid.buildTypes[index / cols] + "|" + *grid.platforms[index % cols]);
+            });
+            return patterns;
+        }
+
+        void AppendConfigRule(std::vector<ConfigRule>& rules, const char* dimension, const ConfigBits& selected, const ConfigGrid& grid,
+            const char* value)
+        {
+            for (auto& pattern : CoverSolutionConfigs(selected, grid)) {
+                ConfigRule& rule = rules.emplace_back();
+                rule.dimension   = dimension;
+                if (pattern != "*|*") {
+                    rule.solution = std::move(pattern);
+                }
+                if (value != nullptr) {
+                    rule.hasValue = true;
+                    rule.value    = value;
+                }
+            }
+        }
+
+        // 把按槽位索引的位集换成按网格下标索引
+        ConfigBits GatherCells(const ConfigBits& slots, const ConfigGrid& grid)
+        {
+            if (grid.identity) {
+                return slots;
+            }
+            ConfigBits cells(grid.Size());
+            for (size_t index = 0; index < grid.Size(); ++index) {
+                if (grid.slotOfCell[index] != ConfigMappingTable::kNoRow && slots.Test(grid.slotOfCell[index])) {
+                    cells.Set(index);
+                }
+            }
+            return cells;
+        }
+
+        std::vector<ConfigRule> ComputeConfigRules(uint32_t project, const SolutionData& data, const ConfigGrid& grid)
+        {
+            std::vector<ConfigRule> rules;
+
+            const size_t              cols  = grid.platforms.size();
+            const ConfigMappingTable& table = data.configs;
+
+            std::map<std::string, ConfigBits> buildTypeRules;
+            std::map<std::string, ConfigBits> platformRules;
+            for (uint32_t row = table.Begin(project); row < table.End(project); ++row) {
+                if (!(table.flags[row] & kMappingActive)) {
+                    continue;
+                }
+                std::string_view projectBuildType = data.strings.View(table.buildTypes[row]);
+                std::string_view projectPlatform  = data.strings.View(table.platforms[row]);
+                uint32_t         index            = grid.cellOfSlot[table.Slot(table.solutionConfigs[row])];
+                if (index == ConfigMappingTable::kNoRow) {
+                    continue;
+                }
+                if (!projectBuildType.empty() && projectBuildType != *grid.buildTypes[index / cols]) {
+                    buildTypeRules.try_emplace(std::string(projectBuildType), grid.Size()).first->second.Set(index);
+                }
+                if (!projectPlatform.empty() && projectPlatform != *grid.platforms[index % cols]) {
+                    platformRules.try_emplace(std::string(projectPlatform), grid.Size()).first->second.Set(index);
+                }
+            }
+
+            for (const auto& [value, selected] : buildTypeRules) {
+                AppendConfigRule(rules, "BuildType", selected, grid, value.c_str());
+            }
+            for (const auto& [value, selected] : platformRules) {
+                AppendConfigRule(rules, "Platform", selected, grid, value.c_str());
+            }
+            // 全部配置都构建、没有任何部署是最常见的情况，按字比较即可跳过
+            const ConfigBits& build = table.BuildBits(project);
+            if (!grid.identity || !build.All()) {
+                ConfigBits noBuild = ~GatherCells(build, grid);
+                if (noBuild.Any()) {
+                    AppendConfigRule(rules, "Build", noBuild, grid, "false");
+                }
+            }
+            const ConfigBits& deploy = table.DeployBits(project);
+            if (deploy.Any()) {
+                ConfigBits cells = GatherCells(deploy, grid);
+                if (cells.Any()) {
+                    AppendConfigRule(rules, "Deploy", cells, grid, nullptr);
+                }
+            }
+            return rules;
+        }
+
+
+        void AppendProjectXml(XmlWriter& xml, uint32_t projectIndex, const SolutionData& data, const std::vector<ConfigRule>& rules,
+            const CanonicalPaths* canonical)
+        {
+            const ProjectEntry& project = data.projects[projectIndex];
+            xml.OpenElement("Project");
+            xml.Attribute("Path", project.path);
+            auto typeAttribute = SlnxTypeAttribute(project.path, project.typeGuid);
+            if (!typeAttribute.empty()) {
+                xml.Attribute("Type", typeAttribute);
+            }
+            xml.Attribute("Id", NormalizeGuidForSlnx(project.guid));
+
+            std::vector<const std::string*> depPaths;
+            for (const auto& dep : project.dependencies) {
+                auto depPath = data.guidToPath.find(dep);
+                if (depPath != data.guidToPath.end()) {
+                    depPaths.push_back(&depPath->second);
+                }
+            }
+            if (canonical != nullptr) {
+                // 依赖列表很短，直接按已算好的排名比较
+                std::stable_sort(depPaths.begin(), depPaths.end(),
+                    [&](const std::string* a, const std::string* b) { return canonical->Rank(*a) < canonical->Rank(*b); });
+            }
+            for (const std::string* depPath : depPaths) {
+                xml.OpenElement("BuildDependency");
+                xml.Attribute("Project", *depPath);
+                xml.CloseElement();
+            }
+            for (const auto& rule : rules) {
+                xml.OpenElement(rule.dimension);
+                if (!rule.solution.empty()) {
+                    xml.Attribute("Solution", rule.solution);
+                }
+                if (rule.hasValue) {
+                    xml.Attribute("Project", rule.value);
+                }
+                xml.CloseElement();
+            }
+            AppendPropertiesXml(xml, project.properties);
+            xml.CloseElement();
+        }
+
+    }  // namespace
+
+    std::vector<std::string_view> SlnxText::Views() const
+    {
+        std::vector<std::string_view> views;
+        views.reserve(pieces.size());
+        for (const auto& piece : pieces) {
+            views.emplace_back(buffers[piece.buffer].data() + piece.offset, piece.size);
+        }
+        return views;
+    }
+
+    size_t SlnxText::Size() const
+    {
+        size_t size = 0;
+        for (const auto& piece : pieces) {
+            size += piece.size;
+        }
+        return size;
+    }
+
+    SlnxText RenderSlnx(const SolutionData& data, const SlnxWriteOptions& options)
+    {
+        ConfigGrid grid;
+        for (const auto& buildType : data.buildTypes) {
+            grid.buildTypes.push_back(&buildType);
+        }
+        for (const auto& platform : data.platforms) {
+            grid.platforms.push_back(&platform);
+        }
+        const size_t rows = grid.buildTypes.size();
+        const size_t cols = grid.platforms.size();
+        grid.rowMasks.assign(rows, ConfigBits(grid.Size()));
+        grid.colMasks.assign(cols, ConfigBits(grid.Size()));
+        grid.cellOfSlot.assign(data.configs.SlotCount(), ConfigMappingTable::kNoRow);
+        grid.identity = grid.Size() == data.configs.SlotCount();
+        for (size_t index = 0; index < grid.Size(); ++index) {
+            uint32_t id   = data.strings.Find(*grid.buildTypes[index / cols] + "|" + *grid.platforms[index % cols]);
+            uint32_t slot = id == StringPool::kNone ? ConfigMappingTable::kNoRow : data.configs.Slot(id);
+            grid.slotOfCell.push_back(slot);
+            grid.identity = grid.identity && slot == index;
+            grid.rowMasks[index / cols].Set(index);
+            grid.colMasks[index % cols].Set(index);
+            if (slot != ConfigMappingTable::kNoRow) {
+                grid.cellOfSlot[slot] = static_cast<uint32_t>(index);
+            }
+        }
+
+        std::unordered_map<std::string, std::string> folderPaths;
+        std::unordered_map<std::string, bool>        visiting;
+        std::vector<std::string>                     folderPathOf(data.projects.size());
+        {
+            TraceSpan span("ResolveFolders");
+            for (size_t index = 0; index < data.projects.size(); ++index) {
+                if (data.projects[index].isSolutionFolder) {
+                    folderPathOf[index] = ResolveFolderPath(data.projects[index].guid, data, folderPaths, visiting);
+                }
+            }
+        }
+
+        // 规范模式下文件夹、项目和解决方案项都按路径排序，路径相同的保持 .sln 中的先后
+        std::vector<uint32_t> order(data.projects.size());
+        std::iota(order.begin(), order.end(), 0u);
+        CanonicalPaths canonical;
+        if (options.canonical) {
+            TraceSpan             span("CanonicalOrder");
+            std::vector<uint32_t> ids;
+            for (size_t index = 0; index < data.projects.size(); ++index) {
+                const ProjectEntry& project = data.projects[index];
+                ids.push_back(canonical.pool.Intern(project.isSolutionFolder ? folderPathOf[index] : project.path));
+            }
+            for (const auto& [guid, path] : data.guidToPath) {
+                canonical.pool.Intern(path);
+            }
+            for (const auto& project : data.projects) {
+                for (const auto& item : project.solutionItems) {
+                    canonical.pool.Intern(item);
+                }
+            }
+            canonical.rank = RankStrings(canonical.pool);
+            for (uint32_t& id : ids) {
+                id = canonical.rank[id];
+            }
+            order = StableOrderByKey(ids);
+        }
+
+        // 同名文件夹合并为一个元素，解决方案项按出现顺序汇总到该元素下
+        struct FolderXml
+        {
+            const std::string*              path = nullptr;
+            std::string                     id;
+            std::vector<const std::string*> items;
+            std::vector<uint32_t>           projects;
+        };
+        std::vector<FolderXml>                  folderXml;
+        std::unordered_map<std::string, size_t> folderByPath;
+        std::unordered_map<std::string, size_t> folderByGuid;
+        for (uint32_t index : order) {
+            const ProjectEntry& project = data.projects[index];
+            if (!project.isSolutionFolder) {
+                continue;
+            }
+            const std::string& path = folderPathOf[index];
+            auto [iter, inserted]   = folderByPath.emplace(path, folderXml.size());
+            if (inserted) {
+                folderXml.push_back({ &path, NormalizeGuidForSlnx(project.guid), {}, {} });
+            }
+            FolderXml& folder = folderXml[iter->second];
+            for (const auto& item : project.solutionItems) {
+                folder.items.push_back(&item);
+            }
+            folderByGuid[project.guid] = iter->second;
+        }
+        if (options.canonical) {
+            for (auto& folder : folderXml) {
+                std::stable_sort(folder.items.begin(), folder.items.end(),
+                    [&](const std::string* a, const std::string* b) { return canonical.Rank(*a) < canonical.Rank(*b); });
+            }
+        }
+
+        // 项目按输出顺序挂到所属文件夹或根元素下，所在深度决定片段的缩进
+        std::vector<uint32_t> rootProjects;
+        std::vector<uint8_t>  depthOf(data.projects.size(), 1);
+        for (uint32_t index : order) {
+            const ProjectEntry& project = data.projects[index];
+            if (project.isSolutionFolder) {
+                continue;
+            }
+            auto nested = data.nestedProjects.find(project.guid);
+            auto folder = nested == data.nestedProjects.end() ? folderByGuid.end() : folderByGuid.find(nested->second);
+            if (folder != folderByGuid.end()) {
+                folderXml[folder->second].projects.push_back(index);
+                depthOf[index] = 2;
+            } else {
+                rootProjects.push_back(index);
+            }
+        }
+
+        // 配置规则的覆盖计算和项目元素的渲染是写出的主要开销，各项目互不依赖：
+        // 按项目区间并行，每个区间渲染到以区间起点为下标的缓冲区，之后按输出顺序引用各片段，不再复制；
+        // 最后一个缓冲区是骨架
+        SlnxText                     text;
+        std::vector<SlnxText::Piece> fragments(data.projects.size());
+        text.buffers.resize(data.projects.size() + 1);
+        auto renderProjects = [&](size_t begin, size_t end) {
+            TraceSpan    span("RenderProjects");
+            std::string& buffer = text.buffers[begin];
+            for (size_t index = begin; index < end; ++index) {
+                const ProjectEntry& project = data.projects[index];
+                if (project.isSolutionFolder) {
+                    continue;
+                }
+                std::vector<ConfigRule> rules;
+                if (HasConfigurations(project.kind)) {
+                    rules = ComputeConfigRules(static_cast<uint32_t>(index), data, grid);
+                }
+                size_t    offset = buffer.size();
+                XmlWriter xml(buffer, depthOf[index], false);
+                AppendProjectXml(xml, static_cast<uint32_t>(index), data, rules, options.canonical ? &canonical : nullptr);
+                fragments[index] = { begin, offset, buffer.size() - offset };
+            }
+        };
+        if (options.runRanges) {
+            options.runRanges(data.projects.size(), renderProjects);
+        } else if (!data.projects.empty()) {
+            renderProjects(0, data.projects.size());
+        }
+
+        // 其余元素写入骨架；输出由骨架的各段与项目片段交替组成，同一缓冲区中相邻的片段合并为一段
+        const size_t skeletonIndex = data.projects.size();
+        std::string& skeleton      = text.buffers[skeletonIndex];
+        size_t       skeletonCut   = 0;
+        auto         addPiece      = [&text](SlnxText::Piece piece) {
+            auto& pieces = text.pieces;
+            if (!pieces.empty() && pieces.back().buffer == piece.buffer && pieces.back().offset + pieces.back().size == piece.offset) {
+                pieces.back().size += piece.size;
+            } else {
+                pieces.push_back(piece);
+            }
+        };
+        XmlWriter xml(skeleton);
+        auto      spliceProjects = [&](const std::vector<uint32_t>& projects) {
+            if (projects.empty()) {
+                return;
+            }
+            xml.SealElement();
+            addPiece({ skeletonIndex, skeletonCut, skeleton.size() - skeletonCut });
+            skeletonCut = skeleton.size();
+            for (uint32_t index : projects) {
+                addPiece(fragments[index]);
+            }
+        };
+        {
+            TraceSpan span("EmitXml");
+            xml.OpenElement("Solution");
+            AppendBuildTypesAndPlatforms(xml, data);
+            AppendPropertiesXml(xml, data.properties);
+            for (const auto& folder : folderXml) {
+                xml.OpenElement("Folder");
+                xml.Attribute("Name", *folder.path);
+                xml.Attribute("Id", folder.id);
+                for (const std::string* item : folder.items) {
+                    xml.OpenElement("File");
+                    xml.Attribute("Path", *item);
+                    xml.CloseElement();
+                }
+                spliceProjects(folder.projects);
+                xml.CloseElement();
+            }
+            spliceProjects(rootProjects);
+            xml.CloseElement();
+            addPiece({ skeletonIndex, skeletonCut, skeleton.size() - skeletonCut });
+        }
+        return text;
+    }
+
+    void WriteSlnx(const fs::path& outputPath, const SolutionData& data, const SlnxWriteOptions& options)
+    {
+        SlnxText    text     = RenderSlnx(data, options);
+        std::string pathText = outputPath.string();
+        TraceSpan   writeSpan("write", pathText);
+        WriteGathered(outputPath, text.Views());
+    }
+
+}  // namespace gotoslnx
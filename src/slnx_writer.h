@@ -0,0 +1,44 @@
+#pragma once
+
+#include "solution.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    struct SlnxWriteOptions
+    {
+        // 文件夹、项目、构建依赖和解决方案项都按路径的字节序排列，输出与 .sln 中的顺序无关
+        bool canonical = false;
+        // 非空时按项目区间并行计算配置规则并渲染项目元素，其余元素在调用线程中写出
+        RangeRunner runRanges;
+    };
+
+    // 渲染好的 .slnx：按 pieces 的顺序依次拼接各段即为完整文件，各段引用 buffers 中的文本
+    struct SlnxText
+    {
+        struct Piece
+        {
+            size_t buffer = 0;  // buffers 的下标
+            size_t offset = 0;
+            size_t size   = 0;
+        };
+
+        std::vector<std::string> buffers;
+        std::vector<Piece>       pieces;
+
+        // 视图在 buffers 改动之前有效
+        std::vector<std::string_view> Views() const;
+        size_t                        Size() const;
+    };
+
+    SlnxText RenderSlnx(const SolutionData& data, const SlnxWriteOptions& options = {});
+    void     WriteSlnx(const std::filesystem::path& outputPath, const SolutionData& data, const SlnxWriteOptions& options = {});
+
+}  // namespace gotoslnx
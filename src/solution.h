@@ -0,0 +1,82 @@
+#pragma once
+
+#include "config_table.h"
+#include "guid_util.h"
+#include "project_types.h"
+#include "string_pool.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 对 [0, count) 的若干区间调用 fn(begin, end)，可并行执行
+    using RangeRunner = std::function<void(size_t count, const std::function<void(size_t, size_t)>& fn)>;
+
+    constexpr std::string_view kSolutionFolderTypeGuid = "{2150E333-8FDC-42A3-9474-1A3956D46DE8}";
+    constexpr std::string_view kSolutionItemsTypeGuid  = "{66A26720-8FB5-11D2-AA7E-00C04F688DDE}";
+
+    // slnx 中 SolutionProperties 对应的 Properties 名称
+    constexpr std::string_view kSolutionPropertiesSection = "SolutionProperties";
+    constexpr std::string_view kSlnxSolutionProperties    = "Visual Studio";
+
+    // 没有结构含义的 GlobalSection / ProjectSection，按键值对原样保留，写出为 slnx 的 Properties
+    struct PropertySection
+    {
+        std::string                                      name;
+        bool                                             postLoad = false;  // postSolution / postProject
+        std::vector<std::pair<std::string, std::string>> entries;
+    };
+
+    struct ProjectEntry
+    {
+        std::string                  typeGuid;
+        std::string                  name;
+        std::string                  path;
+        std::string                  guid;
+        std::vector<std::string>     dependencies;
+        std::vector<std::string>     solutionItems;
+        std::vector<PropertySection> properties;  // 如 WebsiteProperties
+        ProjectKind                  kind             = ProjectKind::Unknown;
+        bool                         isSolutionFolder = false;
+    };
+
+    struct SolutionData
+    {
+        StringPool                                           strings;
+        std::vector<ProjectEntry>                            projects;
+        ConfigMappingTable                                   configs;
+        std::unordered_map<std::string, size_t>              guidToIndex;
+        std::unordered_map<GuidBytes, size_t, GuidBytesHash> guidBytesToIndex;  // 只由 .sln 解析维护，供配置行按字节查找项目
+        std::unordered_map<std::string, std::string>         guidToPath;
+        std::unordered_map<std::string, std::string>         guidToName;
+        std::unordered_map<std::string, std::string>         nestedProjects;
+        std::set<std::string>                                solutionConfigs;
+        std::set<std::string>                                buildTypes;
+        std::set<std::string>                                platforms;
+        std::vector<PropertySection>                         properties;  // 如 SolutionProperties、SharedMSBuildProjectFiles
+    };
+
+    inline std::optional<ConfigMapping> FindConfigMapping(const SolutionData& data, size_t project, uint32_t solutionConfig)
+    {
+        uint32_t row = data.configs.Find(static_cast<uint32_t>(project), solutionConfig);
+        if (row == ConfigMappingTable::kNoRow) {
+            return std::nullopt;
+        }
+        return data.configs.Row(row);
+    }
+
+    inline std::optional<ConfigMapping> FindConfigMapping(const SolutionData& data, size_t project, std::string_view solutionConfig)
+    {
+        return FindConfigMapping(data, project, data.strings.Find(solutionConfig));
+    }
+
+}  // namespace gotoslnx
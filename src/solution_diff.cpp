@@ -0,0 +1,456 @@
+#include "solution_diff.h"
+#include "guid_util.h"
+#include "sln_parser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <compare>
+#include <cstdint>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        // 指纹不同的项目才展开成这种逐字段可比的形式
+        struct NormalizedProject
+        {
+            std::string              guid;
+            std::string              name;
+            std::string              path;
+            std::string              folder;
+            std::vector<std::string> dependencies;
+            std::vector<std::string> mappings;  // 与网格中的配置一一对应
+        };
+
+        class Fingerprint
+        {
+        public:
+            void Add(std::string_view text)
+            {
+                for (unsigned char ch : text) {
+                    Byte(ch);
+                }
+                // 字段分隔符，避免 "ab"+"c" 与 "a"+"bc" 碰撞
+                Byte(0xFF);
+            }
+
+            // 与 NormalizePath 的结果等价：反斜杠按正斜杠计
+            void AddPath(std::string_view path)
+            {
+                for (unsigned char ch : path) {
+                    Byte(ch == '\\' ? '/' : ch);
+                }
+                Byte(0xFF);
+            }
+
+            // 与 NormalizeGuidForSlnx 的结果等价：去掉花括号、忽略大小写
+            void AddGuid(std::string_view guid)
+            {
+                for (unsigned char ch : guid) {
+                    if (ch != '{' && ch != '}') {
+                        Byte(static_cast<unsigned char>(std::tolower(ch)));
+                    }
+                }
+                Byte(0xFF);
+            }
+
+            void AddWord(uint64_t word)
+            {
+                for (int shift = 0; shift < 64; shift += 8) {
+                    Byte(static_cast<unsigned char>(word >> shift));
+                }
+            }
+
+            uint64_t Value() const { return m_hash; }
+
+        private:
+            void Byte(unsigned char ch) { m_hash = (m_hash ^ ch) * 0x100000001b3ULL; }
+
+            uint64_t m_hash = 0xcbf29ce484222325ULL;
+        };
+
+        // splitmix64 的收尾混合；各配置格的贡献相加，与映射行的顺序无关
+        uint64_t Mix(uint64_t value)
+        {
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+            return value ^ (value >> 31);
+        }
+
+        std::string NormalizePath(std::string_view path)
+        {
+            std::string output(path);
+            std::replace(output.begin(), output.end(), '\\', '/');
+            return output;
+        }
+
+        // 规范化 GUID 的精确比较键：合法 GUID 存 16 字节（其字节序与小写文本的字典序一致），
+        // 其余的存 NormalizeGuidForSlnx 的文本，排在所有合法 GUID 之后
+        struct ProjectKey
+        {
+            GuidBytes   bytes {};
+            std::string malformed;
+
+            auto operator<=>(const ProjectKey&) const = default;
+        };
+
+        ProjectKey MakeProjectKey(std::string_view guid)
+        {
+            ProjectKey key;
+            char       braced[kBracedGuidLength];
+            size_t     length = 1;
+            for (char ch : guid) {
+                if (ch == '{' || ch == '}') {
+                    continue;
+                }
+                if (length > kSlnxGuidLength) {
+                    length = 0;
+                    break;
+                }
+                braced[length++] = ch;
+            }
+            braced[0]                     = '{';
+            braced[kBracedGuidLength - 1] = '}';
+            if (length != kSlnxGuidLength + 1 || !DecodeBracedGuid(std::string_view(braced, kBracedGuidLength), key.bytes)) {
+                key.bytes     = {};
+                key.malformed = NormalizeGuidForSlnx(guid);
+            }
+            return key;
+        }
+
+        struct ProjectDigest
+        {
+            ProjectKey key;
+            size_t     index       = 0;
+            uint64_t   fingerprint = 0;
+        };
+
+        struct FolderDigest
+        {
+            std::string           path;
+            std::vector<size_t>   members;  // 解析到同一路径的文件夹项目
+            std::vector<uint64_t> itemHashes;
+            uint64_t              fingerprint = 0;
+        };
+
+        using ConfigGrid = std::vector<std::pair<std::string, std::string>>;
+
+        // 一侧解决方案的指纹：直接对原始字段与映射行的标志位取哈希，不生成规范化字符串；
+        // 只有指纹不同的项目才由 NormalizeProject 展开
+        class SolutionDigest
+        {
+        public:
+            SolutionDigest(const SolutionData& data, const ConfigGrid& grid)
+                : m_data(data)
+                , m_gridOf(data.strings.Size(), ConfigMappingTable::kNoRow)
+                , m_stringHashes(data.strings.Size(), 0)
+            {
+                for (size_t cell = 0; cell < grid.size(); ++cell) {
+                    uint32_t id = data.strings.Find(grid[cell].first + "|" + grid[cell].second);
+                    if (id != StringPool::kNone) {
+                        m_gridOf[id] = static_cast<uint32_t>(cell);
+                    }
+                }
+
+                std::unordered_map<std::string, size_t> folderIndex;
+                std::vector<uint64_t>                   depHashes;
+                for (size_t index = 0; index < data.projects.size(); ++index) {
+                    const ProjectEntry& project = data.projects[index];
+                    if (project.isSolutionFolder) {
+                        std::string path = ResolveFolderPath(project.guid, data, m_folderPaths, m_visiting);
+                        auto [iter, inserted] = folderIndex.emplace(path, folders.size());
+                        if (inserted) {
+                            folders.push_back({ std::move(path), {}, {}, 0 });
+                        }
+                        FolderDigest& folder = folders[iter->second];
+                        folder.members.push_back(index);
+                        for (const auto& item : project.solutionItems) {
+                            Fingerprint hash;
+                            hash.AddPath(item);
+                            folder.itemHashes.push_back(hash.Value());
+                        }
+                        continue;
+                    }
+
+                    Fingerprint fingerprint;
+                    fingerprint.Add(project.name);
+                    fingerprint.AddPath(project.path);
+                    fingerprint.AddWord(FolderHash(project.guid));
+
+                    depHashes.clear();
+                    for (const auto& dep : project.dependencies) {
+                        Fingerprint hash;
+                        hash.AddGuid(dep);
+                        depHashes.push_back(hash.Value());
+                    }
+                    std::sort(depHashes.begin(), depHashes.end());
+                    depHashes.erase(std::unique(depHashes.begin(), depHashes.end()), depHashes.end());
+                    for (uint64_t hash : depHashes) {
+                        fingerprint.AddWord(hash);
+                    }
+                    fingerprint.AddWord(depHashes.size());
+                    fingerprint.AddWord(MappingHash(index));
+
+                    projects.push_back({ MakeProjectKey(project.guid), index, fingerprint.Value() });
+                }
+
+                for (auto& folder : folders) {
+                    std::sort(folder.itemHashes.begin(), folder.itemHashes.end());
+                    Fingerprint fingerprint;
+                    for (uint64_t hash : folder.itemHashes) {
+                        fingerprint.AddWord(hash);
+                    }
+                    folder.fingerprint = fingerprint.Value();
+                }
+
+                std::sort(projects.begin(), projects.end(), [](const ProjectDigest& a, const ProjectDigest& b) { return a.key < b.key; });
+                std::sort(folders.begin(), folders.end(), [](const FolderDigest& a, const FolderDigest& b) { return a.path < b.path; });
+            }
+
+            std::vector<ProjectDigest> projects;
+            std::vector<FolderDigest>  folders;
+
+            const SolutionData& Data() const { return m_data; }
+
+            std::string FolderOf(const ProjectEntry& project)
+            {
+                auto nested = m_data.nestedProjects.find(project.guid);
+                return nested == m_data.nestedProjects.end() ? "/" : ResolveFolderPath(nested->second, m_data, m_folderPaths, m_visiting);
+            }
+
+        private:
+            uint64_t StringHash(uint32_t id)
+            {
+                if (id == StringPool::kNone) {
+                    return 0;
+                }
+                uint64_t& hash = m_stringHashes[id];
+                if (hash == 0) {
+                    Fingerprint fingerprint;
+                    fingerprint.Add(m_data.strings.View(id));
+                    hash = fingerprint.Value();
+                }
+                return hash;
+            }
+
+            uint64_t FolderHash(const std::string& projectGuid)
+            {
+                auto nested = m_data.nestedProjects.find(projectGuid);
+                if (nested == m_data.nestedProjects.end()) {
+                    return 0;
+                }
+                auto [iter, inserted] = m_folderHashes.emplace(nested->second, 0);
+                if (inserted) {
+                    Fingerprint fingerprint;
+                    fingerprint.Add(ResolveFolderPath(nested->second, m_data, m_folderPaths, m_visiting));
+                    iter->second = fingerprint.Value();
+                }
+                return iter->second;
+            }
+
+            // 只有带 ActiveCfg 的格子会影响比较结果；没有映射行与没有 ActiveCfg 的格子都按“不参与构建”处理，不计入
+            uint64_t MappingHash(size_t project)
+            {
+                const ConfigMappingTable& table = m_data.configs;
+                uint64_t                  sum   = 0;
+                for (uint32_t row = table.Begin(static_cast<uint32_t>(project)); row < table.End(static_cast<uint32_t>(project)); ++row) {
+                    uint32_t cell  = m_gridOf[table.solutionConfigs[row]];
+                    uint8_t  flags = table.flags[row];
+                    if (cell == ConfigMappingTable::kNoRow || (flags & kMappingActive) == 0) {
+                        continue;
+                    }
+                    uint64_t value = Mix(cell + 1);
+                    value          = Mix(value ^ StringHash(table.buildTypes[row]));
+                    value          = Mix(value ^ StringHash(table.platforms[row]));
+                    sum += Mix(value ^ (flags & (kMappingBuild | kMappingDeploy)));
+                }
+                return sum;
+            }
+
+            const SolutionData&                            m_data;
+            std::vector<uint32_t>                          m_gridOf;  // 解决方案配置 id -> 网格下标
+            std::vector<uint64_t>                          m_stringHashes;
+            std::unordered_map<std::string, std::string>   m_folderPaths;
+            std::unordered_map<std::string, bool>          m_visiting;
+            std::unordered_map<std::string_view, uint64_t> m_folderHashes;  // 父文件夹 GUID -> 路径哈希
+        };
+
+        std::string DescribeMapping(const SolutionData& data, const ConfigMapping* mapping, const std::string& buildType,
+            const std::string& platform)
+        {
+            if (mapping == nullptr || !mapping->Has(kMappingActive)) {
+                return fmt::format("{}|{} build=false deploy=false", buildType, platform);
+            }
+            return fmt::format("{}|{} build={} deploy={}", data.strings.View(mapping->projectBuildType),
+                data.strings.View(mapping->projectPlatform), mapping->Has(kMappingBuild), mapping->Has(kMappingDeploy));
+        }
+
+        NormalizedProject NormalizeProject(SolutionDigest& digest, size_t index, const ConfigGrid& grid,
+            const std::vector<std::string>& configs)
+        {
+            const SolutionData& data    = digest.Data();
+            const ProjectEntry& project = data.projects[index];
+            NormalizedProject   entry;
+            entry.guid   = NormalizeGuidForSlnx(project.guid);
+            entry.name   = project.name;
+            entry.path   = NormalizePath(project.path);
+            entry.folder = digest.FolderOf(project);
+            for (const auto& dep : project.dependencies) {
+                entry.dependencies.push_back(NormalizeGuidForSlnx(dep));
+            }
+            std::sort(entry.dependencies.begin(), entry.dependencies.end());
+            entry.dependencies.erase(std::unique(entry.dependencies.begin(), entry.dependencies.end()), entry.dependencies.end());
+            for (size_t i = 0; i < grid.size(); ++i) {
+                auto mapping = FindConfigMapping(data, index, configs[i]);
+                entry.mappings.push_back(DescribeMapping(data, mapping ? &*mapping : nullptr, grid[i].first, grid[i].second));
+            }
+            return entry;
+        }
+
+        std::vector<std::string> FolderItems(const SolutionData& data, const FolderDigest& folder)
+        {
+            std::vector<std::string> items;
+            for (size_t member : folder.members) {
+                for (const auto& item : data.projects[member].solutionItems) {
+                    items.push_back(NormalizePath(item));
+                }
+            }
+            std::sort(items.begin(), items.end());
+            return items;
+        }
+
+        template <typename T>
+        void CompareSets(const std::vector<T>& expected, const std::vector<T>& actual, const std::string& subject,
+            std::string_view what, SolutionDiff& diff)
+        {
+            std::vector<T> missing;
+            std::vector<T> extra;
+            std::set_difference(expected.begin(), expected.end(), actual.begin(), actual.end(), std::back_inserter(missing));
+            std::set_difference(actual.begin(), actual.end(), expected.begin(), expected.end(), std::back_inserter(extra));
+            for (const auto& value : missing) {
+                diff.entries.push_back({ subject, fmt::format("缺少{}: {}", what, value) });
+            }
+            for (const auto& value : extra) {
+                diff.entries.push_back({ subject, fmt::format("多出{}: {}", what, value) });
+            }
+        }
+
+        void CompareProject(const NormalizedProject& expected, const NormalizedProject& actual, const std::vector<std::string>& configs,
+            SolutionDiff& diff)
+        {
+            std::string subject = fmt::format("项目 {}", expected.path);
+            if (expected.name != actual.name) {
+                diff.entries.push_back({ subject, fmt::format("名称: {} -> {}", expected.name, actual.name) });
+            }
+            if (expected.path != actual.path) {
+                diff.entries.push_back({ subject, fmt::format("路径: {} -> {}", expected.path, actual.path) });
+            }
+            if (expected.folder != actual.folder) {
+                diff.entries.push_back({ subject, fmt::format("所属文件夹: {} -> {}", expected.folder, actual.folder) });
+            }
+            CompareSets(expected.dependencies, actual.dependencies, subject, "依赖", diff);
+            for (size_t i = 0; i < configs.size(); ++i) {
+                if (expected.mappings[i] != actual.mappings[i]) {
+                    diff.entries.push_back(
+                        { subject, fmt::format("配置 {}: {} -> {}", configs[i], expected.mappings[i], actual.mappings[i]) });
+                }
+            }
+        }
+
+    }  // namespace
+
+    SolutionDiff CompareSolutions(const SolutionData& expected, const SolutionData& actual)
+    {
+        SolutionDiff diff;
+
+        std::vector<std::string> expectedBuildTypes(expected.buildTypes.begin(), expected.buildTypes.end());
+        std::vector<std::string> actualBuildTypes(actual.buildTypes.begin(), actual.buildTypes.end());
+        std::vector<std::string> expectedPlatforms(expected.platforms.begin(), expected.platforms.end());
+        std::vector<std::string> actualPlatforms(actual.platforms.begin(), actual.platforms.end());
+        CompareSets(expectedBuildTypes, actualBuildTypes, "配置", " BuildType", diff);
+        CompareSets(expectedPlatforms, actualPlatforms, "配置", " Platform", diff);
+
+        // 两侧都按源解决方案的 BuildType × Platform 展开，缺失的映射视为“不参与构建”
+        ConfigGrid grid;
+        for (const auto& buildType : expected.buildTypes) {
+            for (const auto& platform : expected.platforms) {
+                grid.emplace_back(buildType, platform);
+            }
+        }
+
+        std::vector<std::string> configs;
+        for (const auto& [buildType, platform] : grid) {
+            configs.push_back(buildType + "|" + platform);
+        }
+
+        SolutionDigest left(expected, grid);
+        SolutionDigest right(actual, grid);
+        diff.comparedProjects = left.projects.size();
+        diff.comparedFolders  = left.folders.size();
+
+        auto describe = [](const SolutionData& data, const ProjectDigest& digest) {
+            const ProjectEntry& project = data.projects[digest.index];
+            return std::pair { fmt::format("项目 {}", NormalizePath(project.path)), NormalizeGuidForSlnx(project.guid) };
+        };
+        auto leftProject  = left.projects.begin();
+        auto rightProject = right.projects.begin();
+        while (leftProject != left.projects.end() || rightProject != right.projects.end()) {
+            if (rightProject == right.projects.end() || (leftProject != left.projects.end() && leftProject->key < rightProject->key)) {
+                auto [subject, guid] = describe(expected, *leftProject);
+                diff.entries.push_back({ subject, fmt::format("在 .slnx 中缺失（{}）", guid) });
+                ++leftProject;
+            } else if (leftProject == left.projects.end() || rightProject->key < leftProject->key) {
+                auto [subject, guid] = describe(actual, *rightProject);
+                diff.entries.push_back({ subject, fmt::format("仅存在于 .slnx（{}）", guid) });
+                ++rightProject;
+            } else {
+                if (leftProject->fingerprint != rightProject->fingerprint) {
+                    CompareProject(NormalizeProject(left, leftProject->index, grid, configs),
+                        NormalizeProject(right, rightProject->index, grid, configs), configs, diff);
+                }
+                ++leftProject;
+                ++rightProject;
+            }
+        }
+
+        auto leftFolder  = left.folders.begin();
+        auto rightFolder = right.folders.begin();
+        while (leftFolder != left.folders.end() || rightFolder != right.folders.end()) {
+            if (rightFolder == right.folders.end() || (leftFolder != left.folders.end() && leftFolder->path < rightFolder->path)) {
+                diff.entries.push_back({ fmt::format("文件夹 {}", leftFolder->path), "在 .slnx 中缺失" });
+                ++leftFolder;
+            } else if (leftFolder == left.folders.end() || rightFolder->path < leftFolder->path) {
+                diff.entries.push_back({ fmt::format("文件夹 {}", rightFolder->path), "仅存在于 .slnx" });
+                ++rightFolder;
+            } else {
+                if (leftFolder->fingerprint != rightFolder->fingerprint) {
+                    CompareSets(FolderItems(expected, *leftFolder), FolderItems(actual, *rightFolder),
+                        fmt::format("文件夹 {}", leftFolder->path), "解决方案项", diff);
+                }
+                ++leftFolder;
+                ++rightFolder;
+            }
+        }
+        return diff;
+    }
+
+    std::string FormatSolutionDiff(const SolutionDiff& diff)
+    {
+        std::string out;
+        std::string lastSubject;
+        for (const auto& entry : diff.entries) {
+            if (entry.subject != lastSubject) {
+                out += fmt::format("  [{}]\n", entry.subject);
+                lastSubject = entry.subject;
+            }
+            out += fmt::format("    - {}\n", entry.detail);
+        }
+        return out;
+    }
+
+}  // namespace gotoslnx
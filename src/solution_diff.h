@@ -0,0 +1,31 @@
+#pragma once
+
+#include "solution.h"
+
+#include <string>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    struct SolutionDiffEntry
+    {
+        std::string subject;  // 如 "项目 src/App/App.csproj"、"文件夹 /src/"、"配置"
+        std::string detail;
+    };
+
+    struct SolutionDiff
+    {
+        size_t                         comparedProjects = 0;
+        size_t                         comparedFolders  = 0;
+        std::vector<SolutionDiffEntry> entries;
+
+        bool Empty() const { return entries.empty(); }
+    };
+
+    // 语义比较两个解决方案：先按项目 / 文件夹的规范化指纹比对，仅在指纹不同时展开字段级差异
+    SolutionDiff CompareSolutions(const SolutionData& expected, const SolutionData& actual);
+
+    std::string FormatSolutionDiff(const SolutionDiff& diff);
+
+}  // namespace gotoslnx
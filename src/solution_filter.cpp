@@ -0,0 +1,229 @@
+#include "solution_filter.h"
+#include "json_util.h"
+#include "sln_parser.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <fmt/format.h>
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        std::string NormalizeFolderQuery(std::string_view query)
+        {
+            std::string path = "/";
+            for (char ch : query) {
+                char normalized = ch == '\\' ? '/' : ch;
+                if (normalized == '/' && path.back() == '/') {
+                    continue;
+                }
+                path.push_back(normalized);
+            }
+            if (path.back() != '/') {
+                path.push_back('/');
+            }
+            return path;
+        }
+
+        std::string FilterName(const FilterQuery& query)
+        {
+            std::string name;
+            for (char ch : query.value) {
+                if (ch == '/' || ch == '\\') {
+                    if (!name.empty() && name.back() != '-') {
+                        name.push_back('-');
+                    }
+                } else if (std::string_view(":*?\"<>|{}").find(ch) != std::string_view::npos) {
+                    continue;
+                } else {
+                    name.push_back(ch);
+                }
+            }
+            while (!name.empty() && name.back() == '-') {
+                name.pop_back();
+            }
+            return name.empty() ? "root" : name;
+        }
+
+        // 不同查询可能得到同名筛选器（同一查询写了两次、"src/Core" 与 "src-Core"、只差大小写），
+        // 文件名会互相覆盖；后出现的依次加上 -2、-3 等后缀。按不区分大小写比较，兼顾 Windows 与 macOS 的文件系统
+        std::string UniqueFilterName(std::string name, std::unordered_set<std::string>& usedNames)
+        {
+            auto key = [](std::string_view text) {
+                std::string lower(text);
+                for (auto& ch : lower) {
+                    ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+                }
+                return lower;
+            };
+            std::string candidate = name;
+            for (size_t suffix = 2; !usedNames.insert(key(candidate)).second; ++suffix) {
+                candidate = fmt::format("{}-{}", name, suffix);
+            }
+            return candidate;
+        }
+
+        bool MatchesProject(const ProjectEntry& project, std::string_view query)
+        {
+            return EqualsIgnoreCase(project.name, query) || EqualsIgnoreCase(project.path, query)
+                || EqualsIgnoreCase(NormalizeGuidForSlnx(project.guid), NormalizeGuidForSlnx(query));
+        }
+
+    }  // namespace
+
+    std::vector<std::vector<uint64_t>> ComputeDependencyClosures(
+        const DependencyGraph& graph, const GraphAnalysis& analysis, const std::vector<std::vector<uint32_t>>& roots)
+    {
+        const size_t componentCount = analysis.components.size();
+
+        auto forEachDependency = [&](size_t c, auto&& fn) {
+            for (uint32_t node : analysis.components[c]) {
+                for (uint32_t e = graph.edgeOffsets[node]; e < graph.edgeOffsets[node + 1]; ++e) {
+                    uint32_t dep = analysis.componentOf[graph.edges[e]];
+                    if (dep != c) {
+                        fn(dep);
+                    }
+                }
+            }
+        };
+
+        // 分量按依赖在前的顺序排列，从后往前扫一遍即可标出根可达的全部分量
+        std::vector<uint8_t> needed(componentCount, 0);
+        for (const auto& group : roots) {
+            for (uint32_t node : group) {
+                needed[analysis.componentOf[node]] = 1;
+            }
+        }
+        for (size_t c = componentCount; c-- > 0;) {
+            if (needed[c]) {
+                forEachDependency(c, [&](uint32_t dep) { needed[dep] = 1; });
+            }
+        }
+
+        // 可达节点按分量顺序重新编号，每 64 个一批
+        std::vector<uint32_t> components;
+        std::vector<uint32_t> dense;
+        for (uint32_t c = 0; c < componentCount; ++c) {
+            if (needed[c]) {
+                components.push_back(c);
+                dense.insert(dense.end(), analysis.components[c].begin(), analysis.components[c].end());
+            }
+        }
+
+        const size_t                       words = (graph.nodes.size() + 63) / 64;
+        std::vector<std::vector<uint64_t>> closures(roots.size(), std::vector<uint64_t>(words, 0));
+        std::vector<uint64_t>              reach(componentCount, 0);
+        size_t                             first      = 0;  // 本批之前的分量只依赖更靠前的分量，到不了本批的节点
+        size_t                             firstBegin = 0;
+        for (size_t base = 0; base < dense.size(); base += 64) {
+            while (firstBegin + analysis.components[components[first]].size() <= base) {
+                firstBegin += analysis.components[components[first]].size();
+                reach[components[first++]] = 0;
+            }
+            size_t begin = firstBegin;  // 分量在 dense 中的起点
+            for (size_t i = first; i < components.size(); ++i) {
+                uint32_t c = components[i];
+                // 分量自身落在本批的节点
+                size_t   low  = std::max(begin, base);
+                size_t   high = std::min(begin + analysis.components[c].size(), base + 64);
+                uint64_t word = 0;
+                if (low < high) {
+                    word = (high - low == 64 ? ~uint64_t(0) : (uint64_t(1) << (high - low)) - 1) << (low - base);
+                }
+                begin += analysis.components[c].size();
+                forEachDependency(c, [&](uint32_t dep) { word |= reach[dep]; });
+                reach[c] = word;
+            }
+            for (size_t q = 0; q < roots.size(); ++q) {
+                uint64_t word = 0;
+                for (uint32_t node : roots[q]) {
+                    word |= reach[analysis.componentOf[node]];
+                }
+                for (; word != 0; word &= word - 1) {
+                    uint32_t node = dense[base + std::countr_zero(word)];
+                    closures[q][node / 64] |= uint64_t(1) << (node % 64);
+                }
+            }
+        }
+        return closures;
+    }
+
+    std::vector<SolutionFilter> BuildSolutionFilters(const SolutionData& data, const std::vector<FilterQuery>& queries)
+    {
+        DependencyGraph   graph    = BuildDependencyGraph(data);
+        GraphAnalysis     analysis = AnalyzeDependencyGraph(graph);
+
+        std::unordered_map<std::string, std::string> folderPaths;
+        std::unordered_map<std::string, bool>        visiting;
+        std::vector<std::string>                     projectFolders(graph.nodes.size());
+        for (uint32_t node = 0; node < graph.nodes.size(); ++node) {
+            const ProjectEntry& project = data.projects[graph.nodes[node]];
+            auto                nested  = data.nestedProjects.find(project.guid);
+            projectFolders[node]
+                = nested == data.nestedProjects.end() ? "/" : ResolveFolderPath(nested->second, data, folderPaths, visiting);
+        }
+
+        std::vector<std::vector<uint32_t>> roots(queries.size());
+        for (size_t q = 0; q < queries.size(); ++q) {
+            const FilterQuery& query = queries[q];
+            if (query.kind == FilterQuery::Kind::Folder) {
+                std::string folder = NormalizeFolderQuery(query.value);
+                for (uint32_t node = 0; node < graph.nodes.size(); ++node) {
+                    const std::string& path = projectFolders[node];
+                    if (path.size() >= folder.size() && EqualsIgnoreCase(std::string_view(path).substr(0, folder.size()), folder)) {
+                        roots[q].push_back(node);
+                    }
+                }
+                if (roots[q].empty()) {
+                    throw std::runtime_error(fmt::format("解决方案文件夹 {} 不存在或不含项目。", folder));
+                }
+            } else {
+                for (uint32_t node = 0; node < graph.nodes.size(); ++node) {
+                    if (MatchesProject(data.projects[graph.nodes[node]], query.value)) {
+                        roots[q].push_back(node);
+                    }
+                }
+                if (roots[q].empty()) {
+                    throw std::runtime_error(fmt::format("未找到项目 {}。", query.value));
+                }
+            }
+        }
+
+        std::vector<std::vector<uint64_t>> closures = ComputeDependencyClosures(graph, analysis, roots);
+        std::vector<SolutionFilter>        filters;
+        std::unordered_set<std::string>    usedNames;
+        for (size_t q = 0; q < queries.size(); ++q) {
+            SolutionFilter filter;
+            filter.name = UniqueFilterName(FilterName(queries[q]), usedNames);
+            for (uint32_t node = 0; node < graph.nodes.size(); ++node) {
+                if (closures[q][node / 64] & (uint64_t(1) << (node % 64))) {
+                    filter.projects.push_back(graph.nodes[node]);
+                }
+            }
+            filters.push_back(std::move(filter));
+        }
+        return filters;
+    }
+
+    std::string FormatSlnf(const std::string& solutionPath, const SolutionData& data, const SolutionFilter& filter)
+    {
+        std::string out = "{\n  \"solution\": {\n    \"path\": ";
+        AppendJsonString(out, solutionPath);
+        out += ",\n    \"projects\": [";
+        for (size_t i = 0; i < filter.projects.size(); ++i) {
+            out += i == 0 ? "\n      " : ",\n      ";
+            AppendJsonString(out, data.projects[filter.projects[i]].path);
+        }
+        out += filter.projects.empty() ? "]\n  }\n}\n" : "\n    ]\n  }\n}\n";
+        return out;
+    }
+
+}  // namespace gotoslnx
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "dependency_graph.h"
+#include "solution.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 一次算出多组根节点的依赖闭包（含根自身），每组结果是以节点下标为位的位图。
+    // 只处理根可达的强连通分量，按 64 个节点一批传播，每批每个分量只占一个字，内存与节点数成线性
+    std::vector<std::vector<uint64_t>> ComputeDependencyClosures(
+        const DependencyGraph& graph, const GraphAnalysis& analysis, const std::vector<std::vector<uint32_t>>& roots);
+
+    struct FilterQuery
+    {
+        enum class Kind
+        {
+            Folder,
+            Project,
+        };
+
+        Kind        kind;
+        std::string value;
+    };
+
+    struct SolutionFilter
+    {
+        std::string         name;
+        std::vector<size_t> projects;  // SolutionData::projects 下标，按原顺序
+    };
+
+    std::vector<SolutionFilter> BuildSolutionFilters(const SolutionData& data, const std::vector<FilterQuery>& queries);
+    std::string                 FormatSlnf(const std::string& solutionPath, const SolutionData& data, const SolutionFilter& filter);
+
+}  // namespace gotoslnx
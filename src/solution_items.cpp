@@ -0,0 +1,187 @@
+#include "solution_items.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <system_error>
+
+#include <fmt/format.h>
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        constexpr size_t kFoldersPerTask  = 16;
+        constexpr size_t kProjectsPerTask = 256;
+
+        std::string FoldCase(std::string_view name)
+        {
+            std::string folded(name);
+            std::transform(
+                folded.begin(), folded.end(), folded.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+            return folded;
+        }
+
+        // Windows 的路径不区分大小写，目录键也按 ASCII 折叠
+        std::string DirectoryKey(const fs::path& directory)
+        {
+#ifdef _WIN32
+            return FoldCase(directory.lexically_normal().generic_string());
+#else
+            return directory.lexically_normal().generic_string();
+#endif
+        }
+
+    }  // namespace
+
+    DirectoryListingCache::Listing& DirectoryListingCache::Lookup(const fs::path& directory)
+    {
+        Listing* listing = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto& slot = m_listings[DirectoryKey(directory)];
+            if (!slot) {
+                slot = std::make_unique<Listing>();
+            }
+            listing = slot.get();
+        }
+        // 列举在锁外进行，不同目录可以同时列举；同一目录的其他查询等待首个线程完成
+        std::call_once(listing->once, [&] {
+            std::string     directoryText = directory.string();
+            TraceSpan       span("ListDirectory", directoryText);
+            std::error_code ec;
+            for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+                std::string name = it->path().filename().string();
+                // 只差大小写的同名文件取字典序最小的一个，结果与列举顺序无关
+                auto [folded, inserted] = listing->folded.emplace(FoldCase(name), name);
+                if (!inserted && name < folded->second) {
+                    folded->second = name;
+                }
+                listing->names.insert(std::move(name));
+            }
+        });
+        return *listing;
+    }
+
+    std::optional<std::string> DirectoryListingCache::Resolve(const fs::path& baseDir, std::string_view path)
+    {
+        std::string portable(path);
+        std::replace(portable.begin(), portable.end(), '\\', '/');
+        if (fs::path(portable).has_root_path()) {
+            // 绝对路径不在索引范围内，只做精确检查
+            std::error_code ec;
+            return fs::exists(portable, ec) ? std::optional<std::string>(path) : std::nullopt;
+        }
+
+        fs::path    current = baseDir.empty() ? fs::path(".") : baseDir;
+        std::string resolved;
+        resolved.reserve(path.size());
+        size_t begin = 0;
+        while (true) {
+            size_t           end       = std::min(path.find_first_of("/\\", begin), path.size());
+            std::string_view component = path.substr(begin, end - begin);
+            if (component.empty() || component == ".") {
+                resolved += component;
+            } else if (component == "..") {
+                resolved += component;
+                current /= "..";
+            } else {
+                const Listing& listing = Lookup(current);
+                std::string    name(component);
+                if (listing.names.count(name) == 0) {
+                    auto folded = listing.folded.find(FoldCase(component));
+                    if (folded == listing.folded.end()) {
+                        return std::nullopt;
+                    }
+                    name = folded->second;
+                }
+                resolved += name;
+                current /= name;
+            }
+            if (end == path.size()) {
+                break;
+            }
+            resolved += path[end];
+            begin = end + 1;
+        }
+        return resolved;
+    }
+
+    std::vector<MissingSolutionItem> CheckSolutionItems(
+        SolutionData& data, const fs::path& baseDir, MissingItemPolicy policy, DirectoryListingCache& cache, TaskScheduler& scheduler)
+    {
+        TraceSpan span("CheckSolutionItems");
+
+        std::vector<uint32_t> folders;
+        for (uint32_t index = 0; index < data.projects.size(); ++index) {
+            if (!data.projects[index].solutionItems.empty()) {
+                folders.push_back(index);
+            }
+        }
+
+        std::vector<std::vector<MissingSolutionItem>> missingByFolder(folders.size());
+        scheduler.ParallelFor(folders.size(), kFoldersPerTask, [&](size_t begin, size_t end) {
+            for (size_t slot = begin; slot < end; ++slot) {
+                auto& items = data.projects[folders[slot]].solutionItems;
+                auto  last  = std::remove_if(items.begin(), items.end(), [&](const std::string& item) {
+                    if (cache.Resolve(baseDir, item)) {
+                        return false;
+                    }
+                    missingByFolder[slot].push_back({ folders[slot], item });
+                    return policy == MissingItemPolicy::Drop;
+                });
+                items.erase(last, items.end());
+            }
+        });
+
+        std::vector<MissingSolutionItem> missing;
+        for (auto& group : missingByFolder) {
+            std::move(group.begin(), group.end(), std::back_inserter(missing));
+        }
+        return missing;
+    }
+
+    size_t FixPathCase(SolutionData& data, const fs::path& baseDir, DirectoryListingCache& cache, TaskScheduler& scheduler)
+    {
+        TraceSpan           span("FixPathCase");
+        std::atomic<size_t> fixed { 0 };
+        auto                fix = [&](std::string& path) {
+            std::optional<std::string> resolved = cache.Resolve(baseDir, path);
+            if (resolved && *resolved != path) {
+                path = std::move(*resolved);
+                fixed.fetch_add(1, std::memory_order_relaxed);
+            }
+        };
+        scheduler.ParallelFor(data.projects.size(), kProjectsPerTask, [&](size_t begin, size_t end) {
+            for (size_t index = begin; index < end; ++index) {
+                ProjectEntry& project = data.projects[index];
+                if (!project.isSolutionFolder) {
+                    fix(project.path);
+                }
+                for (auto& item : project.solutionItems) {
+                    fix(item);
+                }
+            }
+        });
+        if (fixed.load() != 0) {
+            for (const auto& project : data.projects) {
+                if (!project.isSolutionFolder) {
+                    data.guidToPath[project.guid] = project.path;
+                }
+            }
+        }
+        return fixed.load();
+    }
+
+    std::string DescribeMissingItem(const SolutionData& data, const MissingSolutionItem& item, MissingItemPolicy policy)
+    {
+        return fmt::format("解决方案项不存在: {}（文件夹 {}）{}", item.path, data.projects[item.folder].name,
+            policy == MissingItemPolicy::Drop ? "，已移除" : "");
+    }
+
+}  // namespace gotoslnx
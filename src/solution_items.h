@@ -0,0 +1,65 @@
+#pragma once
+
+#include "solution.h"
+#include "work_stealing.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 按目录缓存的文件索引：每个目录只列举一次，文件名另按 ASCII 大小写折叠建索引，
+    // Windows 上写出的、大小写与磁盘不符的路径也能解析。可多线程、多个解决方案共用
+    class DirectoryListingCache
+    {
+    public:
+        // path 相对 baseDir，分隔符不限；逐级在目录索引中查找，每级一次哈希查找。
+        // 返回按磁盘上实际大小写改写的 path（分隔符与 . / .. 原样保留），任一级不存在时返回空
+        std::optional<std::string> Resolve(const std::filesystem::path& baseDir, std::string_view path);
+
+    private:
+        struct Listing
+        {
+            std::once_flag                               once;
+            std::unordered_set<std::string>              names;
+            std::unordered_map<std::string, std::string> folded;  // 折叠后的文件名 -> 磁盘上的文件名
+        };
+
+        Listing& Lookup(const std::filesystem::path& directory);
+
+        std::mutex                                                m_mutex;
+        std::unordered_map<std::string, std::unique_ptr<Listing>> m_listings;
+    };
+
+    enum class MissingItemPolicy
+    {
+        Warn,
+        Drop,
+    };
+
+    struct MissingSolutionItem
+    {
+        uint32_t    folder;  // data.projects 下标
+        std::string path;
+    };
+
+    // 检查全部解决方案项（相对 baseDir）是否存在，各文件夹的检查并行执行；
+    // policy 为 Drop 时缺失的项会从 data 中删除。返回值按文件夹、项的原有顺序排列
+    std::vector<MissingSolutionItem> CheckSolutionItems(SolutionData& data, const std::filesystem::path& baseDir, MissingItemPolicy policy,
+        DirectoryListingCache& cache, TaskScheduler& scheduler);
+
+    // 把项目路径与解决方案项（相对 baseDir）改为磁盘上的实际大小写，找不到的保持不变；返回改动的路径数
+    size_t FixPathCase(SolutionData& data, const std::filesystem::path& baseDir, DirectoryListingCache& cache, TaskScheduler& scheduler);
+
+    std::string DescribeMissingItem(const SolutionData& data, const MissingSolutionItem& item, MissingItemPolicy policy);
+
+}  // namespace gotoslnx
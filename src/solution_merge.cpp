@@ -0,0 +1,221 @@
+#include "solution_merge.h"
+#include "guid_util.h"
+#include "path_rebase.h"
+#include "sln_parser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        std::string PathKey(std::string_view path)
+        {
+            std::string key;
+            key.reserve(path.size());
+            for (unsigned char ch : path) {
+                key.push_back(ch == '/' ? '\\' : static_cast<char>(std::tolower(ch)));
+            }
+            return key;
+        }
+
+        // 每个合并后项目在映射表中占用的行区间；重复项目会在后面的输入中再追加一段
+        using RowSpans = std::vector<std::pair<uint32_t, uint32_t>>;
+
+        // 配置映射引用的是各自解决方案的字符串表，合并时需要改写为目标表中的 id。
+        // 表在全部输入导入后才封存；目标项目已有的配置以先出现的输入为准，只对该项目已导入的行做查重
+        void ImportConfigMappings(const SolutionData& source, size_t project, SolutionData& merged, size_t target, RowSpans& spans)
+        {
+            const ConfigMappingTable& from = source.configs;
+            ConfigMappingTable&       to   = merged.configs;
+
+            std::vector<uint32_t> existing;
+            for (auto [begin, end] : spans) {
+                existing.insert(existing.end(), to.solutionConfigs.begin() + begin, to.solutionConfigs.begin() + end);
+            }
+            std::sort(existing.begin(), existing.end());
+
+            auto first = static_cast<uint32_t>(to.Size());
+            for (uint32_t row = from.Begin(static_cast<uint32_t>(project)); row < from.End(static_cast<uint32_t>(project)); ++row) {
+                uint32_t configId = merged.strings.Intern(source.strings.View(from.solutionConfigs[row]));
+                if (std::binary_search(existing.begin(), existing.end(), configId)) {
+                    continue;
+                }
+                auto [added, inserted] = to.Upsert(static_cast<uint32_t>(target), configId);
+                if (!inserted) {
+                    continue;
+                }
+                to.buildTypes[added] = merged.strings.Intern(source.strings.View(from.buildTypes[row]));
+                to.platforms[added]  = merged.strings.Intern(source.strings.View(from.platforms[row]));
+                to.flags[added]      = from.flags[row];
+            }
+            if (to.Size() != first) {
+                spans.emplace_back(first, static_cast<uint32_t>(to.Size()));
+            }
+        }
+
+        std::string UniqueFolderName(std::string name, std::unordered_map<std::string, size_t>& usedNames)
+        {
+            size_t& count = usedNames[PathKey(name)];
+            ++count;
+            return count == 1 ? name : fmt::format("{} ({})", name, count);
+        }
+
+    }  // namespace
+
+    std::vector<SolutionData> ParseSlnParallel(const std::vector<fs::path>& inputs)
+    {
+        std::vector<SolutionData> results(inputs.size());
+        std::atomic<size_t>       next { 0 };
+        std::exception_ptr        failure;
+        std::mutex                failureMutex;
+
+        auto worker = [&] {
+            for (size_t index = next++; index < inputs.size(); index = next++) {
+                try {
+                    results[index] = ParseSln(inputs[index]);
+                } catch (const std::exception& ex) {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failure) {
+                        failure = std::make_exception_ptr(std::runtime_error(fmt::format("{}: {}", inputs[index].string(), ex.what())));
+                    }
+                }
+            }
+        };
+
+        size_t                   threadCount = std::min<size_t>(inputs.size(), std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < threadCount; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+        return results;
+    }
+
+    MergeResult MergeSolutions(const std::vector<fs::path>& inputs, const std::vector<SolutionData>& solutions, const fs::path& outputDir)
+    {
+        MergeResult   result;
+        SolutionData& merged = result.data;
+
+        // 规范化 GUID -> merged.projects 下标
+        std::unordered_map<std::string, size_t> projectIndex;
+        std::unordered_map<std::string, size_t> usedFolderNames;
+        std::vector<RowSpans>                   mappingRows;  // 与 merged.projects 一一对应
+
+        for (size_t input = 0; input < solutions.size(); ++input) {
+            const SolutionData& source   = solutions[input];
+            PathRebaser         rebaser(inputs[input].parent_path(), outputDir);
+
+            ProjectEntry root;
+            root.typeGuid         = std::string(kSolutionFolderTypeGuid);
+            root.name             = UniqueFolderName(inputs[input].stem().string(), usedFolderNames);
+            root.path             = root.name;
+            root.guid             = MakeDeterministicGuid("merge:" + PathKey(inputs[input].lexically_normal().generic_string()));
+            root.kind             = ProjectKind::SolutionFolder;
+            root.isSolutionFolder = true;
+
+            std::string rootGuid          = root.guid;
+            merged.guidToName[root.guid]  = root.name;
+            merged.guidToIndex[root.guid] = merged.projects.size();
+            projectIndex.emplace(NormalizeGuidForSlnx(root.guid), merged.projects.size());
+            merged.projects.push_back(std::move(root));
+            mappingRows.emplace_back();
+
+            // 本输入内的 GUID 改写表：冲突的项目与文件夹会换成新的 GUID
+            std::unordered_map<std::string, std::string>        remap;
+            std::vector<std::pair<const ProjectEntry*, size_t>> added;
+            std::vector<std::pair<const ProjectEntry*, size_t>> duplicates;  // 与已有项目相同，只合并依赖
+
+            for (size_t sourceIndex = 0; sourceIndex < source.projects.size(); ++sourceIndex) {
+                const ProjectEntry& project = source.projects[sourceIndex];
+                std::string         key     = NormalizeGuidForSlnx(project.guid);
+                auto                found   = projectIndex.find(key);
+
+                ProjectEntry entry = project;
+                if (!project.isSolutionFolder) {
+                    entry.path = rebaser.Rebase(project.path);
+                }
+                for (auto& item : entry.solutionItems) {
+                    item = rebaser.Rebase(item);
+                }
+
+                if (found != projectIndex.end()) {
+                    ProjectEntry& existing = merged.projects[found->second];
+                    if (!project.isSolutionFolder && !existing.isSolutionFolder && PathKey(existing.path) == PathKey(entry.path)) {
+                        ++result.duplicateProjects;
+                        ImportConfigMappings(source, sourceIndex, merged, found->second, mappingRows[found->second]);
+                        duplicates.emplace_back(&project, found->second);
+                        continue;
+                    }
+
+                    std::string newGuid = MakeDeterministicGuid(fmt::format("merge:{}:{}", input, key));
+                    if (!project.isSolutionFolder) {
+                        result.collisions.push_back({ project.guid, existing.path, entry.path, inputs[input], newGuid });
+                    }
+                    remap[project.guid] = newGuid;
+                    entry.guid          = newGuid;
+                    key                 = NormalizeGuidForSlnx(newGuid);
+                }
+
+                projectIndex.emplace(key, merged.projects.size());
+                merged.guidToName[entry.guid]  = entry.name;
+                merged.guidToIndex[entry.guid] = merged.projects.size();
+                if (!entry.isSolutionFolder) {
+                    merged.guidToPath[entry.guid] = entry.path;
+                    ++result.mergedProjects;
+                }
+                mappingRows.emplace_back();
+                ImportConfigMappings(source, sourceIndex, merged, merged.projects.size(), mappingRows.back());
+                added.emplace_back(&project, merged.projects.size());
+                merged.projects.push_back(std::move(entry));
+            }
+
+            auto mapped = [&](const std::string& guid) {
+                auto iter = remap.find(guid);
+                return iter == remap.end() ? guid : iter->second;
+            };
+            for (const auto& [original, index] : added) {
+                ProjectEntry& entry = merged.projects[index];
+                for (auto& dep : entry.dependencies) {
+                    dep = mapped(dep);
+                }
+                auto parent = source.nestedProjects.find(original->guid);
+                merged.nestedProjects[entry.guid] = parent == source.nestedProjects.end() ? rootGuid : mapped(parent->second);
+            }
+            // 依赖可能指向本输入中排在后面、GUID 被改写的项目，要等 remap 完整后再并入
+            for (const auto& [original, index] : duplicates) {
+                ProjectEntry& existing = merged.projects[index];
+                for (const auto& dep : original->dependencies) {
+                    std::string target = mapped(dep);
+                    if (std::find(existing.dependencies.begin(), existing.dependencies.end(), target) == existing.dependencies.end()) {
+                        existing.dependencies.push_back(std::move(target));
+                    }
+                }
+            }
+
+            merged.solutionConfigs.insert(source.solutionConfigs.begin(), source.solutionConfigs.end());
+            merged.buildTypes.insert(source.buildTypes.begin(), source.buildTypes.end());
+            merged.platforms.insert(source.platforms.begin(), source.platforms.end());
+        }
+        merged.configs.Seal(merged.projects.size());
+        return result;
+    }
+
+}  // namespace gotoslnx
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "solution.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    struct MergeCollision
+    {
+        std::string           guid;
+        std::string           keptPath;
+        std::string           conflictingPath;
+        std::filesystem::path source;
+        std::string           reassignedGuid;
+    };
+
+    struct MergeResult
+    {
+        SolutionData                data;
+        size_t                      mergedProjects    = 0;
+        size_t                      duplicateProjects = 0;
+        std::vector<MergeCollision> collisions;
+    };
+
+    // 并行解析多个 .sln，结果顺序与输入一致；任一输入失败时抛出异常
+    std::vector<SolutionData> ParseSlnParallel(const std::vector<std::filesystem::path>& inputs);
+
+    // 每个输入放在以其文件名命名的顶层文件夹下；按 GUID 去重，路径改写为相对 outputDir
+    MergeResult MergeSolutions(const std::vector<std::filesystem::path>& inputs, const std::vector<SolutionData>& solutions,
+        const std::filesystem::path& outputDir);
+
+}  // namespace gotoslnx
@@ -0,0 +1,545 @@
+#include "solution_snapshot.h"
+#include "sln_parser.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        constexpr std::array<char, 8> kMagic     = { 'G', 'S', 'L', 'N', 'S', 'N', 'A', 'P' };
+        constexpr uint32_t            kByteOrder = 0x01020304;  // 按小端写入；大端机器读到的值不同，直接拒绝
+        constexpr size_t              kAlignment = 8;
+
+        enum Section : uint32_t
+        {
+            kStringOffsets,
+            kStringChars,
+            kProjects,
+            kDependencyOffsets,
+            kDependencies,
+            kItemOffsets,
+            kItems,
+            kMappingProjects,
+            kMappingSolutionConfigs,
+            kMappingBuildTypes,
+            kMappingPlatforms,
+            kMappingFlags,
+            kSolutionConfigs,
+            kBuildTypes,
+            kPlatforms,
+            kNestedProjects,
+            kPropertySections,
+            kPropertyEntryOffsets,
+            kPropertyEntries,
+            kSectionCount,
+        };
+
+        struct SectionRef
+        {
+            uint64_t offset;  // 相对文件起始
+            uint64_t count;   // 元素个数
+        };
+
+        struct SnapshotHeader
+        {
+            std::array<char, 8> magic;
+            uint32_t            byteOrder;
+            uint32_t            version;
+            uint32_t            headerSize;
+            uint32_t            configStringCount;
+            uint64_t            fileSize;
+            uint64_t            sourceSize;
+            int64_t             sourceTime;
+            SectionRef          sections[kSectionCount];
+        };
+
+        static_assert(std::is_trivially_copyable_v<SnapshotHeader>);
+        static_assert(std::is_trivially_copyable_v<SnapshotProject>);
+        static_assert(sizeof(SnapshotProject) == 28);
+
+        template <typename T>
+        void AppendSection(std::string& out, SnapshotHeader& header, Section section, const std::vector<T>& values)
+        {
+            out.resize((out.size() + kAlignment - 1) / kAlignment * kAlignment, '\0');
+            header.sections[section] = { out.size(), values.size() };
+            out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+
+        [[noreturn]] void ThrowCorrupt(std::string_view what)
+        {
+            throw std::runtime_error(fmt::format("快照文件已损坏: {}", what));
+        }
+
+        template <typename T>
+        std::span<const T> MapSection(const MappedFile& file, const SnapshotHeader& header, Section section)
+        {
+            const SectionRef& ref = header.sections[section];
+            if (ref.offset % alignof(T) != 0 || ref.offset > file.Size() || ref.count > (file.Size() - ref.offset) / sizeof(T)) {
+                ThrowCorrupt(fmt::format("区段 {} 越界", static_cast<uint32_t>(section)));
+            }
+            return { reinterpret_cast<const T*>(file.Data() + ref.offset), static_cast<size_t>(ref.count) };
+        }
+
+        // CSR 偏移数组：rows + 1 个单调不减的值，首个为 0，末个等于 total
+        void ValidateOffsets(std::span<const uint32_t> offsets, size_t rows, size_t total, std::string_view what)
+        {
+            if (offsets.size() != rows + 1 || offsets.front() != 0 || offsets.back() != total
+                || !std::is_sorted(offsets.begin(), offsets.end())) {
+                ThrowCorrupt(what);
+            }
+        }
+
+        void ValidateIds(std::span<const uint32_t> ids, size_t limit, bool allowNone, std::string_view what)
+        {
+            for (uint32_t id : ids) {
+                if (id >= limit && !(allowNone && id == StringPool::kNone)) {
+                    ThrowCorrupt(what);
+                }
+            }
+        }
+
+        std::optional<SolutionSnapshot> OpenFreshSnapshot(const fs::path& snapshotPath, const SourceStamp& source)
+        {
+            std::error_code error;
+            if (!fs::is_regular_file(snapshotPath, error)) {
+                return std::nullopt;
+            }
+            try {
+                SolutionSnapshot snapshot(snapshotPath);
+                if (snapshot.Source() == source) {
+                    return snapshot;
+                }
+            } catch (const std::exception&) {
+                // 损坏或旧版本的快照按过期处理，随后会被重写
+            }
+            return std::nullopt;
+        }
+
+        // 每个写者用自己的临时文件，并发重写同一快照时互不覆盖半成品
+        fs::path TemporarySnapshotPath(const fs::path& path)
+        {
+            static const uint64_t        writerTag = (uint64_t(std::random_device{}()) << 32) | std::random_device{}();
+            static std::atomic<uint64_t> sequence{ 0 };
+            fs::path                     temporary = path;
+            temporary += fmt::format(".{:016x}-{}.tmp", writerTag, sequence.fetch_add(1, std::memory_order_relaxed));
+            return temporary;
+        }
+
+    }  // namespace
+
+    SourceStamp StampSourceFile(const fs::path& source)
+    {
+        SourceStamp stamp;
+        stamp.size = fs::file_size(source);
+        stamp.time = static_cast<int64_t>(fs::last_write_time(source).time_since_epoch().count());
+        return stamp;
+    }
+
+    SolutionSnapshot::SolutionSnapshot(const fs::path& path)
+        : m_file(path)
+    {
+        TraceSpan span("OpenSnapshot");
+        SnapshotHeader header;
+        if (m_file.Size() < sizeof(header)) {
+            ThrowCorrupt(path.string());
+        }
+        std::memcpy(&header, m_file.Data(), sizeof(header));
+        if (header.magic != kMagic || header.byteOrder != kByteOrder) {
+            throw std::runtime_error(fmt::format("不是 goto-slnx 快照文件: {}", path.string()));
+        }
+        if (header.version != kVersion || header.headerSize != sizeof(header)) {
+            throw std::runtime_error(fmt::format("快照版本不受支持: {}（版本 {}）", path.string(), header.version));
+        }
+        if (header.fileSize != m_file.Size()) {
+            ThrowCorrupt(path.string());
+        }
+
+        m_source                 = { header.sourceSize, header.sourceTime };
+        m_configStringCount      = header.configStringCount;
+        m_stringOffsets          = MapSection<uint32_t>(m_file, header, kStringOffsets);
+        auto chars               = MapSection<char>(m_file, header, kStringChars);
+        m_stringChars            = { chars.data(), chars.size() };
+        m_projects               = MapSection<SnapshotProject>(m_file, header, kProjects);
+        m_dependencyOffsets      = MapSection<uint32_t>(m_file, header, kDependencyOffsets);
+        m_dependencies           = MapSection<uint32_t>(m_file, header, kDependencies);
+        m_itemOffsets            = MapSection<uint32_t>(m_file, header, kItemOffsets);
+        m_items                  = MapSection<uint32_t>(m_file, header, kItems);
+        m_mappingProjects        = MapSection<uint32_t>(m_file, header, kMappingProjects);
+        m_mappingSolutionConfigs = MapSection<uint32_t>(m_file, header, kMappingSolutionConfigs);
+        m_mappingBuildTypes      = MapSection<uint32_t>(m_file, header, kMappingBuildTypes);
+        m_mappingPlatforms       = MapSection<uint32_t>(m_file, header, kMappingPlatforms);
+        m_mappingFlags           = MapSection<uint8_t>(m_file, header, kMappingFlags);
+        m_solutionConfigs        = MapSection<uint32_t>(m_file, header, kSolutionConfigs);
+        m_buildTypes             = MapSection<uint32_t>(m_file, header, kBuildTypes);
+        m_platforms              = MapSection<uint32_t>(m_file, header, kPlatforms);
+        m_nestedProjects         = MapSection<uint32_t>(m_file, header, kNestedProjects);
+        m_propertySections       = MapSection<uint32_t>(m_file, header, kPropertySections);
+        m_propertyEntryOffsets   = MapSection<uint32_t>(m_file, header, kPropertyEntryOffsets);
+        m_propertyEntries        = MapSection<uint32_t>(m_file, header, kPropertyEntries);
+        Validate();
+    }
+
+    // 只检查下标与偏移不越界，保证之后的访问都落在映射范围内；不复制任何数据
+    void SolutionSnapshot::Validate() const
+    {
+        if (m_stringOffsets.empty()) {
+            ThrowCorrupt("字符串表为空");
+        }
+        const size_t stringCount = StringCount();
+        ValidateOffsets(m_stringOffsets, stringCount, m_stringChars.size(), "字符串表");
+        if (m_configStringCount > stringCount) {
+            ThrowCorrupt("配置字符串数");
+        }
+
+        const size_t projectCount = m_projects.size();
+        for (const auto& project : m_projects) {
+            if (project.typeGuid >= stringCount || project.name >= stringCount || project.path >= stringCount
+                || project.guid >= stringCount || project.folderPath >= stringCount
+                || (project.parent >= projectCount && project.parent != kNoParent)) {
+                ThrowCorrupt("项目表");
+            }
+        }
+        ValidateOffsets(m_dependencyOffsets, projectCount, m_dependencies.size(), "项目依赖");
+        ValidateIds(m_dependencies, stringCount, false, "项目依赖");
+        ValidateOffsets(m_itemOffsets, projectCount, m_items.size(), "解决方案项");
+        ValidateIds(m_items, stringCount, false, "解决方案项");
+
+        const size_t rows = m_mappingProjects.size();
+        if (m_mappingSolutionConfigs.size() != rows || m_mappingBuildTypes.size() != rows || m_mappingPlatforms.size() != rows
+            || m_mappingFlags.size() != rows) {
+            ThrowCorrupt("配置映射");
+        }
+        ValidateIds(m_mappingProjects, projectCount, false, "配置映射");
+        ValidateIds(m_mappingSolutionConfigs, m_configStringCount, false, "配置映射");
+        ValidateIds(m_mappingBuildTypes, m_configStringCount, true, "配置映射");
+        ValidateIds(m_mappingPlatforms, m_configStringCount, true, "配置映射");
+
+        ValidateIds(m_solutionConfigs, stringCount, false, "解决方案配置");
+        ValidateIds(m_buildTypes, stringCount, false, "构建类型");
+        ValidateIds(m_platforms, stringCount, false, "平台");
+        if (m_nestedProjects.size() % 2 != 0) {
+            ThrowCorrupt("NestedProjects");
+        }
+        ValidateIds(m_nestedProjects, stringCount, false, "NestedProjects");
+
+        if (m_propertySections.size() % 3 != 0 || m_propertyEntries.size() % 2 != 0) {
+            ThrowCorrupt("属性区段");
+        }
+        ValidateOffsets(m_propertyEntryOffsets, m_propertySections.size() / 3, m_propertyEntries.size() / 2, "属性区段");
+        ValidateIds(m_propertyEntries, stringCount, false, "属性区段");
+        for (size_t record = 0; record < m_propertySections.size(); record += 3) {
+            uint32_t owner = m_propertySections[record];
+            if ((owner >= projectCount && owner != kNoParent) || m_propertySections[record + 1] >= stringCount
+                || m_propertySections[record + 2] > 1) {
+                ThrowCorrupt("属性区段");
+            }
+        }
+    }
+
+    std::string_view SolutionSnapshot::String(uint32_t id) const
+    {
+        return m_stringChars.substr(m_stringOffsets[id], m_stringOffsets[id + 1] - m_stringOffsets[id]);
+    }
+
+    std::span<const uint32_t> SolutionSnapshot::Dependencies(size_t project) const
+    {
+        return m_dependencies.subspan(m_dependencyOffsets[project], m_dependencyOffsets[project + 1] - m_dependencyOffsets[project]);
+    }
+
+    std::span<const uint32_t> SolutionSnapshot::SolutionItems(size_t project) const
+    {
+        return m_items.subspan(m_itemOffsets[project], m_itemOffsets[project + 1] - m_itemOffsets[project]);
+    }
+
+    SolutionData SolutionSnapshot::ToSolutionData() const
+    {
+        TraceSpan    span("SnapshotToSolutionData");
+        SolutionData data;
+        for (uint32_t id = 0; id < m_configStringCount; ++id) {
+            data.strings.Intern(String(id));
+        }
+
+        auto toStrings = [this](std::span<const uint32_t> ids) {
+            std::vector<std::string> out;
+            out.reserve(ids.size());
+            for (uint32_t id : ids) {
+                out.emplace_back(String(id));
+            }
+            return out;
+        };
+
+        // GUID 索引的写法与 ParseSlnText 一致：名称取最后一次出现，下标取第一次出现
+        data.projects.reserve(m_projects.size());
+        for (size_t index = 0; index < m_projects.size(); ++index) {
+            const SnapshotProject& record = m_projects[index];
+            ProjectEntry           entry;
+            entry.typeGuid         = String(record.typeGuid);
+            entry.name             = String(record.name);
+            entry.path             = String(record.path);
+            entry.guid             = String(record.guid);
+            entry.dependencies     = toStrings(Dependencies(index));
+            entry.solutionItems    = toStrings(SolutionItems(index));
+            entry.kind             = static_cast<ProjectKind>(record.kind);
+            entry.isSolutionFolder = record.isSolutionFolder != 0;
+
+            data.guidToName[entry.guid] = entry.name;
+            data.guidToIndex.emplace(entry.guid, index);
+            if (!entry.isSolutionFolder) {
+                data.guidToPath[entry.guid] = entry.path;
+            }
+            data.projects.push_back(std::move(entry));
+        }
+
+        for (size_t pair = 0; pair < m_nestedProjects.size(); pair += 2) {
+            data.nestedProjects.emplace(String(m_nestedProjects[pair]), String(m_nestedProjects[pair + 1]));
+        }
+        for (uint32_t id : m_solutionConfigs) {
+            data.solutionConfigs.emplace(String(id));
+        }
+        for (uint32_t id : m_buildTypes) {
+            data.buildTypes.emplace(String(id));
+        }
+        for (uint32_t id : m_platforms) {
+            data.platforms.emplace(String(id));
+        }
+
+        for (size_t section = 0; section * 3 < m_propertySections.size(); ++section) {
+            const uint32_t*               record = &m_propertySections[section * 3];
+            std::vector<PropertySection>& owner  = record[0] == kNoParent ? data.properties : data.projects[record[0]].properties;
+            PropertySection&              target = owner.emplace_back();
+            target.name                          = String(record[1]);
+            target.postLoad                      = record[2] != 0;
+            for (uint32_t entry = m_propertyEntryOffsets[section]; entry < m_propertyEntryOffsets[section + 1]; ++entry) {
+                target.entries.emplace_back(String(m_propertyEntries[entry * 2]), String(m_propertyEntries[entry * 2 + 1]));
+            }
+        }
+
+        for (size_t row = 0; row < m_mappingProjects.size(); ++row) {
+            uint32_t index                 = data.configs.Upsert(m_mappingProjects[row], m_mappingSolutionConfigs[row]).first;
+            data.configs.buildTypes[index] = m_mappingBuildTypes[row];
+            data.configs.platforms[index]  = m_mappingPlatforms[row];
+            data.configs.flags[index]      = m_mappingFlags[row];
+        }
+        data.configs.Seal(data.projects.size());
+        return data;
+    }
+
+    fs::path SnapshotPathFor(const fs::path& slnPath)
+    {
+        fs::path path = slnPath;
+        path.replace_extension(kSnapshotExtension);
+        return path;
+    }
+
+    void WriteSolutionSnapshot(const fs::path& path, const SolutionData& data, const SourceStamp& source)
+    {
+        std::string pathText = path.string();
+        TraceSpan   span("WriteSnapshot", pathText);
+
+        // 先按 id 顺序复制 SolutionData::strings，配置映射中的 id 因此可以原样写入
+        StringPool strings;
+        for (uint32_t id = 0; id < data.strings.Size(); ++id) {
+            strings.Intern(data.strings.View(id));
+        }
+        const auto configStringCount = static_cast<uint32_t>(strings.Size());
+
+        // 所在路径沿 NestedProjects 逐级拼接，父 GUID 不是已知项目时仍会继续向上查找。
+        // 先解析普通项目、后解析文件夹，嵌套成环时截断的位置与 --list-projects 相同
+        std::unordered_map<std::string, std::string> folderPaths;
+        std::unordered_map<std::string, bool>        visiting;
+        std::vector<uint32_t>                        parents(data.projects.size(), SolutionSnapshot::kNoParent);
+        std::vector<uint32_t>                        locations(data.projects.size(), StringPool::kNone);
+        for (bool folders : { false, true }) {
+            for (size_t index = 0; index < data.projects.size(); ++index) {
+                const ProjectEntry& project = data.projects[index];
+                if (project.isSolutionFolder != folders) {
+                    continue;
+                }
+                auto nested = data.nestedProjects.find(project.guid);
+                if (nested == data.nestedProjects.end()) {
+                    locations[index] = strings.Intern("/");
+                    continue;
+                }
+                auto parent = data.guidToIndex.find(nested->second);
+                if (parent != data.guidToIndex.end()) {
+                    parents[index] = static_cast<uint32_t>(parent->second);
+                }
+                locations[index] = strings.Intern(ResolveFolderPath(nested->second, data, folderPaths, visiting));
+            }
+        }
+
+        std::vector<SnapshotProject> projects;
+        std::vector<uint32_t>        dependencyOffsets { 0 };
+        std::vector<uint32_t>        dependencies;
+        std::vector<uint32_t>        itemOffsets { 0 };
+        std::vector<uint32_t>        items;
+        projects.reserve(data.projects.size());
+        for (size_t index = 0; index < data.projects.size(); ++index) {
+            const ProjectEntry& project = data.projects[index];
+            SnapshotProject     record {};
+            record.typeGuid         = strings.Intern(project.typeGuid);
+            record.name             = strings.Intern(project.name);
+            record.path             = strings.Intern(project.path);
+            record.guid             = strings.Intern(project.guid);
+            record.parent           = parents[index];
+            record.folderPath       = locations[index];
+            record.kind             = static_cast<uint8_t>(project.kind);
+            record.isSolutionFolder = project.isSolutionFolder ? 1 : 0;
+
+            for (const auto& dependency : project.dependencies) {
+                dependencies.push_back(strings.Intern(dependency));
+            }
+            dependencyOffsets.push_back(static_cast<uint32_t>(dependencies.size()));
+            for (const auto& item : project.solutionItems) {
+                items.push_back(strings.Intern(item));
+            }
+            itemOffsets.push_back(static_cast<uint32_t>(items.size()));
+            projects.push_back(record);
+        }
+
+        std::vector<uint32_t> nestedProjects;
+        nestedProjects.reserve(data.nestedProjects.size() * 2);
+        for (const auto& [child, parent] : data.nestedProjects) {
+            nestedProjects.push_back(strings.Intern(child));
+            nestedProjects.push_back(strings.Intern(parent));
+        }
+        auto internSet = [&strings](const std::set<std::string>& values) {
+            std::vector<uint32_t> ids;
+            ids.reserve(values.size());
+            for (const auto& value : values) {
+                ids.push_back(strings.Intern(value));
+            }
+            return ids;
+        };
+        std::vector<uint32_t> propertySections;  // (所属项目, 名称, postLoad) 三个一组
+        std::vector<uint32_t> propertyEntryOffsets { 0 };
+        std::vector<uint32_t> propertyEntries;  // (键, 值) 成对
+        auto addProperties = [&](uint32_t owner, const std::vector<PropertySection>& sections) {
+            for (const auto& section : sections) {
+                propertySections.insert(propertySections.end(), { owner, strings.Intern(section.name), section.postLoad ? 1u : 0u });
+                for (const auto& [key, value] : section.entries) {
+                    propertyEntries.push_back(strings.Intern(key));
+                    propertyEntries.push_back(strings.Intern(value));
+                }
+                propertyEntryOffsets.push_back(static_cast<uint32_t>(propertyEntries.size() / 2));
+            }
+        };
+        addProperties(SolutionSnapshot::kNoParent, data.properties);
+        for (size_t index = 0; index < data.projects.size(); ++index) {
+            addProperties(static_cast<uint32_t>(index), data.projects[index].properties);
+        }
+
+        std::vector<uint32_t> solutionConfigs = internSet(data.solutionConfigs);
+        std::vector<uint32_t> buildTypes      = internSet(data.buildTypes);
+        std::vector<uint32_t> platforms       = internSet(data.platforms);
+
+        std::vector<uint32_t> stringOffsets { 0 };
+        std::vector<char>     stringChars;
+        stringOffsets.reserve(strings.Size() + 1);
+        for (uint32_t id = 0; id < strings.Size(); ++id) {
+            std::string_view text = strings.View(id);
+            stringChars.insert(stringChars.end(), text.begin(), text.end());
+            stringOffsets.push_back(static_cast<uint32_t>(stringChars.size()));
+        }
+
+        SnapshotHeader header {};
+        header.magic             = kMagic;
+        header.byteOrder         = kByteOrder;
+        header.version           = SolutionSnapshot::kVersion;
+        header.headerSize        = sizeof(header);
+        header.configStringCount = configStringCount;
+        header.sourceSize        = source.size;
+        header.sourceTime        = source.time;
+
+        std::string out(sizeof(header), '\0');
+        AppendSection(out, header, kStringOffsets, stringOffsets);
+        AppendSection(out, header, kStringChars, stringChars);
+        AppendSection(out, header, kProjects, projects);
+        AppendSection(out, header, kDependencyOffsets, dependencyOffsets);
+        AppendSection(out, header, kDependencies, dependencies);
+        AppendSection(out, header, kItemOffsets, itemOffsets);
+        AppendSection(out, header, kItems, items);
+        AppendSection(out, header, kMappingProjects, data.configs.projects);
+        AppendSection(out, header, kMappingSolutionConfigs, data.configs.solutionConfigs);
+        AppendSection(out, header, kMappingBuildTypes, data.configs.buildTypes);
+        AppendSection(out, header, kMappingPlatforms, data.configs.platforms);
+        AppendSection(out, header, kMappingFlags, data.configs.flags);
+        AppendSection(out, header, kSolutionConfigs, solutionConfigs);
+        AppendSection(out, header, kBuildTypes, buildTypes);
+        AppendSection(out, header, kPlatforms, platforms);
+        AppendSection(out, header, kNestedProjects, nestedProjects);
+        AppendSection(out, header, kPropertySections, propertySections);
+        AppendSection(out, header, kPropertyEntryOffsets, propertyEntryOffsets);
+        AppendSection(out, header, kPropertyEntries, propertyEntries);
+        header.fileSize = out.size();
+        std::memcpy(out.data(), &header, sizeof(header));
+
+        fs::path temporary = TemporarySnapshotPath(path);
+        {
+            std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+            if (!stream) {
+                throw std::runtime_error(fmt::format("无法写入快照: {}", temporary.string()));
+            }
+            stream.write(out.data(), static_cast<std::streamsize>(out.size()));
+            if (!stream) {
+                throw std::runtime_error(fmt::format("写入快照失败: {}", temporary.string()));
+            }
+        }
+        std::error_code error;
+        fs::rename(temporary, path, error);
+        if (error) {
+            fs::remove(temporary, error);
+#ifdef _WIN32
+            // Windows 上旧快照仍被映射时不能替换，保留旧快照，下次运行再重写
+            throw std::runtime_error(fmt::format("快照正被占用，保留旧快照: {}", pathText));
+#else
+            throw std::runtime_error(fmt::format("无法替换快照: {}", pathText));
+#endif
+        }
+    }
+
+    fs::path EnsureSolutionSnapshot(const fs::path& slnPath)
+    {
+        fs::path    snapshotPath = SnapshotPathFor(slnPath);
+        SourceStamp source       = StampSourceFile(slnPath);
+        if (!OpenFreshSnapshot(snapshotPath, source)) {
+            WriteSolutionSnapshot(snapshotPath, ParseSln(slnPath), source);
+        }
+        return snapshotPath;
+    }
+
+    SolutionData ParseSlnWithSnapshot(const fs::path& slnPath, std::string& warning)
+    {
+        fs::path    snapshotPath = SnapshotPathFor(slnPath);
+        SourceStamp source       = StampSourceFile(slnPath);
+        if (auto snapshot = OpenFreshSnapshot(snapshotPath, source)) {
+            return snapshot->ToSolutionData();
+        }
+        SolutionData data = ParseSln(slnPath);
+        try {
+            WriteSolutionSnapshot(snapshotPath, data, source);
+        } catch (const std::exception& ex) {
+            warning = ex.what();
+        }
+        return data;
+    }
+
+}  // namespace gotoslnx
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "mapped_file.h"
+#include "solution.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace gotoslnx
+{
+
+    // 解析结果的二进制快照，与 .sln 同目录、同名，扩展名为 .slnsnap
+    inline constexpr const char* kSnapshotExtension = ".slnsnap";
+
+    // 快照中的一个项目；字符串字段都是快照字符串表中的 id
+    struct SnapshotProject
+    {
+        uint32_t typeGuid;
+        uint32_t name;
+        uint32_t path;
+        uint32_t guid;
+        uint32_t parent;      // NestedProjects 中父项目的下标，没有时为 SolutionSnapshot::kNoParent
+        uint32_t folderPath;  // 所在文件夹的完整路径，以 / 开头和结尾，顶层为 "/"
+        uint8_t  kind;        // ProjectKind
+        uint8_t  isSolutionFolder;
+        uint16_t reserved;
+    };
+
+    // 快照对应的源文件版本
+    struct SourceStamp
+    {
+        uint64_t size = 0;
+        int64_t  time = 0;  // 最后修改时间，文件时钟的原始计数
+
+        bool operator==(const SourceStamp&) const = default;
+    };
+
+    SourceStamp StampSourceFile(const std::filesystem::path& source);
+
+    // 以内存映射方式打开的快照。文件内只用相对文件头的偏移，打开时不做反序列化：构造时检查版本与各区段边界，
+    // 下面的访问器直接读映射内存。只有 --list-projects 停留在这一层，转换仍经 ToSolutionData 整体复制
+    class SolutionSnapshot
+    {
+    public:
+        static constexpr uint32_t kVersion  = 2;
+        static constexpr uint32_t kNoParent = UINT32_MAX;
+
+        // 文件损坏、版本不符时抛出 std::runtime_error
+        explicit SolutionSnapshot(const std::filesystem::path& path);
+
+        const SourceStamp& Source() const { return m_source; }
+
+        size_t           StringCount() const { return m_stringOffsets.size() - 1; }
+        std::string_view String(uint32_t id) const;
+
+        std::span<const SnapshotProject> Projects() const { return m_projects; }
+        std::span<const uint32_t>        Dependencies(size_t project) const;
+        std::span<const uint32_t>        SolutionItems(size_t project) const;
+
+        // 复制出与 ParseSln 结果等价的 SolutionData：每个字符串复制一份，映射行逐行插入后 Seal。
+        // 这是完整的反序列化，省掉的只是文本解析，开销仍与快照大小成正比
+        SolutionData ToSolutionData() const;
+
+    private:
+        void Validate() const;
+
+        MappedFile                       m_file;
+        SourceStamp                      m_source;
+        uint32_t                         m_configStringCount = 0;  // 前这么多个字符串与 SolutionData::strings 的 id 一致
+        std::span<const uint32_t>        m_stringOffsets;
+        std::string_view                 m_stringChars;
+        std::span<const SnapshotProject> m_projects;
+        std::span<const uint32_t>        m_dependencyOffsets;
+        std::span<const uint32_t>        m_dependencies;
+        std::span<const uint32_t>        m_itemOffsets;
+        std::span<const uint32_t>        m_items;
+        std::span<const uint32_t>        m_mappingProjects;
+        std::span<const uint32_t>        m_mappingSolutionConfigs;
+        std::span<const uint32_t>        m_mappingBuildTypes;
+        std::span<const uint32_t>        m_mappingPlatforms;
+        std::span<const uint8_t>         m_mappingFlags;
+        std::span<const uint32_t>        m_solutionConfigs;
+        std::span<const uint32_t>        m_buildTypes;
+        std::span<const uint32_t>        m_platforms;
+        std::span<const uint32_t>        m_nestedProjects;    // (子 GUID, 父 GUID) 成对存放
+        std::span<const uint32_t>        m_propertySections;  // (所属项目下标，解决方案级为 kNoParent; 名称; postLoad) 三个一组
+        std::span<const uint32_t>        m_propertyEntryOffsets;
+        std::span<const uint32_t>        m_propertyEntries;  // (键, 值) 成对存放
+    };
+
+    std::filesystem::path SnapshotPathFor(const std::filesystem::path& slnPath);
+
+    // 先写各写者独有的临时文件再改名替换。POSIX 上已映射旧快照的读者不受影响；Windows 上旧快照仍被映射时替换失败，
+    // 保留旧快照并抛出异常。source 应在解析前取得，解析期间源文件被改动时快照随即过期
+    void WriteSolutionSnapshot(const std::filesystem::path& path, const SolutionData& data, const SourceStamp& source);
+
+    // 快照存在且新鲜时返回其路径，否则解析 slnPath 并重写快照
+    std::filesystem::path EnsureSolutionSnapshot(const std::filesystem::path& slnPath);
+
+    // 快照新鲜时经 ToSolutionData 由快照复制，否则解析 .sln 并尽力重写快照；快照写入失败不影响结果，原因记入 warning
+    SolutionData ParseSlnWithSnapshot(const std::filesystem::path& slnPath, std::string& warning);
+
+}  // namespace gotoslnx
@@ -0,0 +1,80 @@
+#include "string_pool.h"
+
+#include <stdexcept>
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        uint64_t HashText(std::string_view text)
+        {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (unsigned char ch : text) {
+                hash = (hash ^ ch) * 0x100000001b3ULL;
+            }
+            return hash;
+        }
+
+    }  // namespace
+
+    uint32_t StringPool::Intern(std::string_view text)
+    {
+        uint64_t hash = HashText(text);
+        if (!m_slots.empty()) {
+            size_t slot = FindSlot(text, hash);
+            if (m_slots[slot] != kNone) {
+                return m_slots[slot];
+            }
+        }
+
+        if (m_chars.size() + text.size() >= kNone) {
+            throw std::runtime_error("字符串表超出容量。");
+        }
+        uint32_t id = static_cast<uint32_t>(Size());
+        m_chars.append(text);
+        m_offsets.push_back(static_cast<uint32_t>(m_chars.size()));
+
+        // 负载因子保持在 1/2 以下
+        if ((Size() + 1) * 2 > m_slots.size()) {
+            Rehash(m_slots.empty() ? 64 : m_slots.size() * 2);
+        } else {
+            m_slots[FindSlot(text, hash)] = id;
+        }
+        return id;
+    }
+
+    uint32_t StringPool::Find(std::string_view text) const
+    {
+        if (m_slots.empty()) {
+            return kNone;
+        }
+        return m_slots[FindSlot(text, HashText(text))];
+    }
+
+    std::string_view StringPool::View(uint32_t id) const
+    {
+        return std::string_view(m_chars).substr(m_offsets[id], m_offsets[id + 1] - m_offsets[id]);
+    }
+
+    size_t StringPool::FindSlot(std::string_view text, uint64_t hash) const
+    {
+        const size_t mask = m_slots.size() - 1;
+        for (size_t slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask) {
+            if (m_slots[slot] == kNone || View(m_slots[slot]) == text) {
+                return slot;
+            }
+        }
+    }
+
+    void StringPool::Rehash(size_t slotCount)
+    {
+        m_slots.assign(slotCount, kNone);
+        for (uint32_t id = 0; id < Size(); ++id) {
+            std::string_view text = View(id);
+            m_slots[FindSlot(text, HashText(text))] = id;
+        }
+    }
+
+}  // namespace gotoslnx
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 字符串驻留表：每个不同的字符串只存一份，以连续的 uint32_t id 引用。
+    // 内容紧凑地存放在同一块缓冲区中，View() 返回的视图在下一次 Intern() 之前有效。
+    class StringPool
+    {
+    public:
+        static constexpr uint32_t kNone = UINT32_MAX;
+
+        uint32_t         Intern(std::string_view text);
+        uint32_t         Find(std::string_view text) const;
+        std::string_view View(uint32_t id) const;
+        size_t           Size() const { return m_offsets.size() - 1; }
+
+    private:
+        size_t FindSlot(std::string_view text, uint64_t hash) const;
+        void   Rehash(size_t slotCount);
+
+        std::string           m_chars;
+        std::vector<uint32_t> m_offsets { 0 };
+        std::vector<uint32_t> m_slots;
+    };
+
+}  // namespace gotoslnx
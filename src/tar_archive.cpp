@@ -0,0 +1,429 @@
+#include "tar_archive.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <zlib.h>
+
+namespace fs = std::filesystem;
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        constexpr size_t   kBlockSize       = 512;
+        constexpr unsigned kGzipBufferSize  = 256 * 1024;
+        constexpr size_t   kMaxGzipRequest  = size_t { 1 } << 30;
+        constexpr uint64_t kMaxMetadataSize = 1024 * 1024;    // 长文件名与 pax 扩展头的上限
+        constexpr uint64_t kMaxOctalValue   = uint64_t { 1 } << 33;  // 11 位八进制
+
+        struct Field
+        {
+            size_t offset;
+            size_t size;
+        };
+
+        constexpr Field kName     = { 0, 100 };
+        constexpr Field kMode     = { 100, 8 };
+        constexpr Field kUid      = { 108, 8 };
+        constexpr Field kGid      = { 116, 8 };
+        constexpr Field kSize     = { 124, 12 };
+        constexpr Field kMtime    = { 136, 12 };
+        constexpr Field kChecksum = { 148, 8 };
+        constexpr Field kTypeFlag = { 156, 1 };
+        constexpr Field kMagic    = { 257, 6 };
+        constexpr Field kVersion  = { 263, 2 };
+        constexpr Field kPrefix   = { 345, 155 };
+
+        uint64_t Padding(uint64_t size)
+        {
+            return (kBlockSize - size % kBlockSize) % kBlockSize;
+        }
+
+        gzFile OpenArchive(const fs::path& path, const char* mode)
+        {
+#ifdef _WIN32
+            return gzopen_w(path.c_str(), mode);
+#else
+            return gzopen(path.c_str(), mode);
+#endif
+        }
+
+        std::string GzipError(gzFile file)
+        {
+            int         code    = Z_OK;
+            const char* message = gzerror(file, &code);
+            return code == Z_ERRNO ? std::strerror(errno) : message;
+        }
+
+        std::runtime_error MalformedArchive(const std::string& path, std::string_view reason)
+        {
+            return std::runtime_error(fmt::format("归档格式错误: {}（{}）", path, reason));
+        }
+
+        // 字段内容截止到第一个 NUL
+        std::string_view FieldText(const char* header, Field field)
+        {
+            const char* begin = header + field.offset;
+            return { begin, static_cast<size_t>(std::find(begin, begin + field.size, '\0') - begin) };
+        }
+
+        // 八进制数，前面可有空格，后面以空格或 NUL 结束；首字节最高位为 1 时是 GNU 的 base-256 大端编码
+        std::optional<uint64_t> ParseNumber(const char* header, Field field)
+        {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(header + field.offset);
+            uint64_t    value = 0;
+            if (bytes[0] & 0x80) {
+                if (bytes[0] & 0x40) {
+                    return std::nullopt;  // 负数
+                }
+                value = bytes[0] & 0x3F;
+                for (size_t i = 1; i < field.size; ++i) {
+                    if (value >> 56) {
+                        return std::nullopt;
+                    }
+                    value = value << 8 | bytes[i];
+                }
+                return value;
+            }
+            size_t i = 0;
+            while (i < field.size && bytes[i] == ' ') {
+                ++i;
+            }
+            size_t digitsStart = i;
+            for (; i < field.size && bytes[i] >= '0' && bytes[i] <= '7'; ++i) {
+                if (value >> 61) {
+                    return std::nullopt;
+                }
+                value = value * 8 + (bytes[i] - '0');
+            }
+            if (i == digitsStart) {
+                return std::nullopt;
+            }
+            for (; i < field.size; ++i) {
+                if (bytes[i] != ' ' && bytes[i] != '\0') {
+                    return std::nullopt;
+                }
+            }
+            return value;
+        }
+
+        // 校验和字段按 8 个空格计入；早期实现按有符号字节求和，两种都接受
+        bool ChecksumMatches(const char* header, uint64_t expected)
+        {
+            uint64_t unsignedSum = 0;
+            int64_t  signedSum   = 0;
+            for (size_t i = 0; i < kBlockSize; ++i) {
+                bool inField = i >= kChecksum.offset && i < kChecksum.offset + kChecksum.size;
+                unsignedSum += inField ? ' ' : static_cast<unsigned char>(header[i]);
+                signedSum += inField ? ' ' : static_cast<signed char>(header[i]);
+            }
+            return expected == unsignedSum || static_cast<int64_t>(expected) == signedSum;
+        }
+
+        unsigned HeaderChecksum(const char* header)
+        {
+            unsigned sum = 0;
+            for (size_t i = 0; i < kBlockSize; ++i) {
+                bool inField = i >= kChecksum.offset && i < kChecksum.offset + kChecksum.size;
+                sum += inField ? ' ' : static_cast<unsigned char>(header[i]);
+            }
+            return sum;
+        }
+
+        // POSIX ustar 才有 prefix 字段；GNU 旧格式的魔数是 "ustar  "，同一位置存放的是别的内容
+        std::string HeaderPath(const char* header)
+        {
+            std::string path(FieldText(header, kName));
+            if (std::memcmp(header + kMagic.offset, "ustar", kMagic.size) == 0) {
+                std::string_view prefix = FieldText(header, kPrefix);
+                if (!prefix.empty()) {
+                    path = fmt::format("{}/{}", prefix, path);
+                }
+            }
+            return path;
+        }
+
+        template <typename T>
+        bool ParseDecimal(std::string_view text, T& value)
+        {
+            auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            return ec == std::errc() && end == text.data() + text.size();
+        }
+
+        // pax 扩展头由 "长度 键=值\n" 形式的记录组成，长度包括记录本身的全部字节
+        bool ParsePaxRecords(
+            std::string_view records, std::string& path, std::optional<uint64_t>& size, std::optional<int64_t>& mtime)
+        {
+            while (!records.empty()) {
+                size_t space  = records.find(' ');
+                size_t length = 0;
+                if (space == std::string_view::npos || !ParseDecimal(records.substr(0, space), length) || length < space + 3
+                    || length > records.size() || records[length - 1] != '\n') {
+                    return false;
+                }
+                std::string_view record = records.substr(space + 1, length - space - 2);
+                records.remove_prefix(length);
+                size_t equals = record.find('=');
+                if (equals == std::string_view::npos) {
+                    return false;
+                }
+                std::string_view key   = record.substr(0, equals);
+                std::string_view value = record.substr(equals + 1);
+                if (key == "path") {
+                    path = std::string(value);
+                } else if (key == "size") {
+                    uint64_t parsed = 0;
+                    if (!ParseDecimal(value, parsed)) {
+                        return false;
+                    }
+                    size = parsed;
+                } else if (key == "mtime") {
+                    // 可带小数部分，只取整秒
+                    int64_t parsed = 0;
+                    if (!ParseDecimal(value.substr(0, value.find('.')), parsed)) {
+                        return false;
+                    }
+                    mtime = parsed;
+                }
+            }
+            return true;
+        }
+
+        void WriteOctal(char* header, Field field, uint64_t value)
+        {
+            // 最后一个字节留作 NUL
+            fmt::format_to_n(header + field.offset, field.size - 1, "{:0{}o}", value, field.size - 1);
+        }
+
+        std::string PaxRecord(std::string_view key, std::string_view value)
+        {
+            // 记录长度包括表示长度的数字本身，位数变化时再算一次
+            size_t body   = key.size() + value.size() + 3;  // 空格、'=' 与换行
+            size_t length = body + 1;
+            while (length != body + fmt::formatted_size("{}", length)) {
+                length = body + fmt::formatted_size("{}", length);
+            }
+            return fmt::format("{} {}={}\n", length, key, value);
+        }
+
+    }  // namespace
+
+    TarReader::TarReader(const fs::path& path)
+        : m_pathText(path.string())
+        , m_file(OpenArchive(path, "rb"))
+    {
+        if (m_file == nullptr) {
+            throw std::runtime_error(fmt::format("无法打开归档: {}", m_pathText));
+        }
+        gzbuffer(m_file, kGzipBufferSize);
+    }
+
+    TarReader::~TarReader()
+    {
+        gzclose(m_file);
+    }
+
+    size_t TarReader::ReadSome(char* data, size_t size)
+    {
+        size_t total = 0;
+        while (total < size) {
+            auto request = static_cast<unsigned>(std::min(size - total, kMaxGzipRequest));
+            int  got     = gzread(m_file, data + total, request);
+            if (got < 0) {
+                throw std::runtime_error(fmt::format("读取归档失败: {}: {}", m_pathText, GzipError(m_file)));
+            }
+            if (got == 0) {
+                break;
+            }
+            total += static_cast<size_t>(got);
+        }
+        return total;
+    }
+
+    void TarReader::ReadExact(char* data, size_t size)
+    {
+        if (ReadSome(data, size) != size) {
+            throw MalformedArchive(m_pathText, "文件意外结束");
+        }
+    }
+
+    void TarReader::Skip(uint64_t size)
+    {
+        char scratch[16 * 1024];
+        while (size != 0) {
+            auto step = static_cast<size_t>(std::min<uint64_t>(size, sizeof(scratch)));
+            ReadExact(scratch, step);
+            size -= step;
+        }
+    }
+
+    bool TarReader::Next(TarMember& member)
+    {
+        Skip(m_remaining + m_padding);
+        m_remaining = 0;
+        m_padding   = 0;
+
+        // 长文件名与 pax 扩展头作用于紧随其后的成员
+        std::string             extendedPath;
+        std::optional<uint64_t> extendedSize;
+        std::optional<int64_t>  extendedMtime;
+        char                    header[kBlockSize];
+        while (true) {
+            size_t got = ReadSome(header, kBlockSize);
+            // 缺少结束标记的归档读到末尾同样视为结束
+            if (got == 0) {
+                return false;
+            }
+            if (got != kBlockSize) {
+                throw MalformedArchive(m_pathText, "文件意外结束");
+            }
+            if (std::all_of(header, header + kBlockSize, [](char c) { return c == '\0'; })) {
+                return false;
+            }
+            auto checksum = ParseNumber(header, kChecksum);
+            if (!checksum || !ChecksumMatches(header, *checksum)) {
+                throw MalformedArchive(m_pathText, "头部校验和不符");
+            }
+            auto size = ParseNumber(header, kSize);
+            if (!size) {
+                throw MalformedArchive(m_pathText, "成员大小无效");
+            }
+
+            char type = header[kTypeFlag.offset];
+            if (type == 'x' || type == 'g' || type == 'L' || type == 'K') {
+                if (*size > kMaxMetadataSize) {
+                    throw MalformedArchive(m_pathText, "扩展头过大");
+                }
+                std::string content(static_cast<size_t>(*size), '\0');
+                ReadExact(content.data(), content.size());
+                Skip(Padding(*size));
+                // 全局 pax 头与 GNU 长链接目标不影响成员路径
+                if (type == 'L') {
+                    extendedPath = content.substr(0, content.find('\0'));
+                } else if (type == 'x' && !ParsePaxRecords(content, extendedPath, extendedSize, extendedMtime)) {
+                    throw MalformedArchive(m_pathText, "pax 扩展头无效");
+                }
+                continue;
+            }
+
+            auto mtime         = ParseNumber(header, kMtime);
+            member.path        = extendedPath.empty() ? HeaderPath(header) : std::move(extendedPath);
+            member.size        = extendedSize.value_or(*size);
+            member.mtime       = extendedMtime.value_or(mtime ? static_cast<int64_t>(*mtime) : 0);
+            member.regularFile = type == '0' || type == '\0' || type == '7';
+            // 链接、设备、目录与 FIFO 没有内容；未知类型按普通文件跳过其内容
+            bool hasContent = type < '1' || type > '6';
+            m_remaining     = hasContent ? member.size : 0;
+            m_padding       = hasContent ? Padding(member.size) : 0;
+            return true;
+        }
+    }
+
+    std::string TarReader::ReadContent()
+    {
+        std::string content(static_cast<size_t>(m_remaining), '\0');
+        ReadExact(content.data(), content.size());
+        Skip(m_padding);
+        m_remaining = 0;
+        m_padding   = 0;
+        return content;
+    }
+
+    TarWriter::TarWriter(const fs::path& path)
+        : m_pathText(path.string())
+    {
+        // 'T' 表示不压缩，直接写出
+        bool gzip = path.extension() == ".gz" || path.extension() == ".tgz";
+        m_file    = OpenArchive(path, gzip ? "wb" : "wbT");
+        if (m_file == nullptr) {
+            throw std::runtime_error(fmt::format("无法写入归档: {}", m_pathText));
+        }
+        gzbuffer(m_file, kGzipBufferSize);
+    }
+
+    TarWriter::~TarWriter()
+    {
+        if (m_file != nullptr) {
+            gzclose(m_file);
+        }
+    }
+
+    void TarWriter::Write(std::string_view data)
+    {
+        while (!data.empty()) {
+            auto request = static_cast<unsigned>(std::min(data.size(), kMaxGzipRequest));
+            if (gzwrite(m_file, data.data(), request) == 0) {
+                throw std::runtime_error(fmt::format("写入归档失败: {}: {}", m_pathText, GzipError(m_file)));
+            }
+            data.remove_prefix(request);
+        }
+    }
+
+    void TarWriter::WritePadding(uint64_t size)
+    {
+        static constexpr char kZeros[kBlockSize] = {};
+        Write({ kZeros, static_cast<size_t>(Padding(size)) });
+    }
+
+    void TarWriter::WriteHeader(std::string_view path, char type, uint64_t size, int64_t mtime)
+    {
+        if (size >= kMaxOctalValue) {
+            throw std::runtime_error(fmt::format("归档成员过大: {}", path));
+        }
+        char header[kBlockSize] = {};
+        path.substr(0, kName.size).copy(header + kName.offset, kName.size);
+        WriteOctal(header, kMode, 0644);
+        WriteOctal(header, kUid, 0);
+        WriteOctal(header, kGid, 0);
+        WriteOctal(header, kSize, size);
+        WriteOctal(header, kMtime, std::clamp<int64_t>(mtime, 0, kMaxOctalValue - 1));
+        header[kTypeFlag.offset] = type;
+        std::memcpy(header + kMagic.offset, "ustar", kMagic.size);
+        std::memcpy(header + kVersion.offset, "00", kVersion.size);
+        // 校验和写作 6 位八进制，后接 NUL 与空格
+        fmt::format_to_n(header + kChecksum.offset, 6, "{:06o}", HeaderChecksum(header));
+        header[kChecksum.offset + 6] = '\0';
+        header[kChecksum.offset + 7] = ' ';
+        Write({ header, kBlockSize });
+    }
+
+    void TarWriter::Add(std::string_view path, int64_t mtime, std::span<const std::string_view> pieces)
+    {
+        uint64_t size = 0;
+        for (std::string_view piece : pieces) {
+            size += piece.size();
+        }
+        if (path.size() > kName.size) {
+            std::string record = PaxRecord("path", path);
+            WriteHeader("././@PaxHeader", 'x', record.size(), mtime);
+            Write(record);
+            WritePadding(record.size());
+        }
+        WriteHeader(path, '0', size, mtime);
+        for (std::string_view piece : pieces) {
+            Write(piece);
+        }
+        WritePadding(size);
+    }
+
+    void TarWriter::Finish()
+    {
+        // 结束标记是两个全零块
+        static constexpr char kEndMarker[kBlockSize * 2] = {};
+        Write({ kEndMarker, sizeof(kEndMarker) });
+        int result = gzclose(m_file);
+        m_file     = nullptr;
+        if (result != Z_OK) {
+            throw std::runtime_error(fmt::format("写入归档失败: {}", m_pathText));
+        }
+    }
+
+}  // namespace gotoslnx
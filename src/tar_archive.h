@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+
+struct gzFile_s;
+
+namespace gotoslnx
+{
+
+    struct TarMember
+    {
+        std::string path;  // 归档内的路径，以 '/' 分隔
+        uint64_t    size        = 0;
+        int64_t     mtime       = 0;  // Unix 时间，秒
+        bool        regularFile = false;
+    };
+
+    // 顺序读取 .tar 或 .tar.gz（按内容识别 gzip），边解压边解析，成员不落盘。
+    // 支持 ustar、GNU 长文件名与 pax 扩展头中的 path、size、mtime；格式不对时抛出 std::runtime_error
+    class TarReader
+    {
+    public:
+        explicit TarReader(const std::filesystem::path& path);
+        ~TarReader();
+
+        TarReader(const TarReader&)            = delete;
+        TarReader& operator=(const TarReader&) = delete;
+
+        // 读下一个成员的头部，上一个成员未读的内容会被跳过；归档结束时返回 false
+        bool        Next(TarMember& member);
+        std::string ReadContent();
+
+    private:
+        size_t ReadSome(char* data, size_t size);
+        void   ReadExact(char* data, size_t size);
+        void   Skip(uint64_t size);
+
+        std::string m_pathText;
+        gzFile_s*   m_file      = nullptr;
+        uint64_t    m_remaining = 0;  // 当前成员未读的内容
+        uint64_t    m_padding   = 0;  // 内容之后补齐到 512 字节的部分
+    };
+
+    // 顺序写出 ustar 格式的 .tar；路径以 .gz 或 .tgz 结尾时用 gzip 压缩。
+    // 超过 100 字节的成员路径写入 pax 扩展头
+    class TarWriter
+    {
+    public:
+        explicit TarWriter(const std::filesystem::path& path);
+        ~TarWriter();
+
+        TarWriter(const TarWriter&)            = delete;
+        TarWriter& operator=(const TarWriter&) = delete;
+
+        // 写出一个普通文件成员，内容为各段依次拼接
+        void Add(std::string_view path, int64_t mtime, std::span<const std::string_view> pieces);
+        // 写出结束标记并关闭；不调用时析构只关闭文件，归档不完整
+        void Finish();
+
+    private:
+        void WriteHeader(std::string_view path, char type, uint64_t size, int64_t mtime);
+        void Write(std::string_view data);
+        void WritePadding(uint64_t size);
+
+        std::string m_pathText;
+        gzFile_s*   m_file = nullptr;
+    };
+
+}  // namespace gotoslnx
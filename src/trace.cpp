@@ -0,0 +1,162 @@
+#include "trace.h"
+#include "json_util.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        constexpr size_t kRingCapacity = 4096;  // 2 的幂
+        constexpr size_t kDetailSize   = 95;
+
+        struct TraceEvent
+        {
+            const char*                   name;
+            uint64_t                      start;
+            uint64_t                      end;
+            uint8_t                       detailSize;
+            std::array<char, kDetailSize> detail;
+        };
+
+        struct ThreadBuffer
+        {
+            uint32_t                      tid = 0;
+            std::string                   name;
+            std::atomic<uint64_t>         head { 0 };  // 已写入的事件总数，只由所属线程递增
+            std::unique_ptr<TraceEvent[]> events { new TraceEvent[kRingCapacity] };
+            ThreadBuffer*                 next = nullptr;
+        };
+
+        std::atomic<bool>                     g_enabled { false };
+        std::atomic<ThreadBuffer*>            g_buffers { nullptr };
+        std::atomic<uint32_t>                 g_nextTid { 0 };
+        std::chrono::steady_clock::time_point g_epoch;
+
+        thread_local ThreadBuffer* t_buffer = nullptr;
+        thread_local std::string   t_threadName;
+
+        ThreadBuffer& CurrentBuffer()
+        {
+            if (t_buffer == nullptr) {
+                // 缓冲区在进程结束前不释放，导出时线程可能已经退出
+                auto* buffer = new ThreadBuffer;
+                buffer->tid  = g_nextTid.fetch_add(1, std::memory_order_relaxed);
+                buffer->name = t_threadName.empty() ? fmt::format("thread {}", buffer->tid) : t_threadName;
+                buffer->next = g_buffers.load(std::memory_order_relaxed);
+                while (!g_buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed)) {
+                }
+                t_buffer = buffer;
+            }
+            return *t_buffer;
+        }
+
+        void AppendMicroseconds(std::string& out, uint64_t nanoseconds)
+        {
+            out += fmt::format("{}.{:03}", nanoseconds / 1000, nanoseconds % 1000);
+        }
+
+    }  // namespace
+
+    void EnableTrace()
+    {
+        g_epoch = std::chrono::steady_clock::now();
+        g_enabled.store(true, std::memory_order_release);
+    }
+
+    bool TraceEnabled()
+    {
+        return g_enabled.load(std::memory_order_relaxed);
+    }
+
+    void SetTraceThreadName(std::string name)
+    {
+        t_threadName = std::move(name);
+    }
+
+    uint64_t TraceNow()
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_epoch).count());
+    }
+
+    void RecordTraceSpan(const char* name, uint64_t start, uint64_t end, std::string_view detail)
+    {
+        ThreadBuffer& buffer = CurrentBuffer();
+        uint64_t      head   = buffer.head.load(std::memory_order_relaxed);
+        TraceEvent&   event  = buffer.events[head & (kRingCapacity - 1)];
+        if (detail.size() > kDetailSize) {
+            // 路径的末尾更有辨识度；跳过被截断的 UTF-8 续字节
+            detail.remove_prefix(detail.size() - kDetailSize);
+            while (!detail.empty() && (static_cast<unsigned char>(detail.front()) & 0xC0) == 0x80) {
+                detail.remove_prefix(1);
+            }
+        }
+        event.name       = name;
+        event.start      = start;
+        event.end        = end;
+        event.detailSize = static_cast<uint8_t>(detail.size());
+        std::copy(detail.begin(), detail.end(), event.detail.begin());
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    std::string FormatTraceJson()
+    {
+        std::vector<const ThreadBuffer*> buffers;
+        for (const ThreadBuffer* buffer = g_buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next) {
+            buffers.push_back(buffer);
+        }
+        std::sort(buffers.begin(), buffers.end(), [](const ThreadBuffer* a, const ThreadBuffer* b) { return a->tid < b->tid; });
+
+        std::string out        = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool        first      = true;
+        auto        beginEvent = [&] {
+            out += first ? "\n" : ",\n";
+            first = false;
+        };
+        for (const ThreadBuffer* buffer : buffers) {
+            beginEvent();
+            out += fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":", buffer->tid);
+            AppendJsonString(out, buffer->name);
+            out += "}}";
+
+            uint64_t head  = buffer->head.load(std::memory_order_acquire);
+            uint64_t begin = head > kRingCapacity ? head - kRingCapacity : 0;
+            for (uint64_t index = begin; index < head; ++index) {
+                const TraceEvent& event = buffer->events[index & (kRingCapacity - 1)];
+                beginEvent();
+                out += "{\"name\":";
+                AppendJsonString(out, event.name);
+                out += ",\"ph\":\"X\",\"ts\":";
+                AppendMicroseconds(out, event.start);
+                out += ",\"dur\":";
+                AppendMicroseconds(out, event.end - event.start);
+                out += fmt::format(",\"pid\":1,\"tid\":{}", buffer->tid);
+                if (event.detailSize != 0) {
+                    out += ",\"args\":{\"detail\":";
+                    AppendJsonString(out, std::string_view(event.detail.data(), event.detailSize));
+                    out.push_back('}');
+                }
+                out.push_back('}');
+            }
+            if (begin != 0) {
+                beginEvent();
+                // 环形缓冲区覆盖掉的事件数
+                out += fmt::format("{{\"name\":\"dropped\",\"ph\":\"i\",\"s\":\"t\",\"ts\":0,\"pid\":1,\"tid\":{},", buffer->tid);
+                out += fmt::format("\"args\":{{\"count\":{}}}}}", begin);
+            }
+        }
+        out += "\n]}\n";
+        return out;
+    }
+
+}  // namespace gotoslnx
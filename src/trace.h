@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace gotoslnx
+{
+
+    // 转换过程的区间记录，导出为 Chrome trace event 格式（chrome://tracing、Perfetto 可直接打开）。
+    // 每个线程写自己的环形缓冲区，写入无锁；缓冲区写满后覆盖最早的事件。
+
+    void EnableTrace();
+    bool TraceEnabled();
+    // 在首次记录前调用才会生效，用作 trace 中的线程名
+    void SetTraceThreadName(std::string name);
+
+    uint64_t TraceNow();
+    // name 必须是静态字符串；detail 会被复制，过长时保留末尾
+    void RecordTraceSpan(const char* name, uint64_t start, uint64_t end, std::string_view detail = {});
+
+    // 调用时不能有线程仍在记录
+    std::string FormatTraceJson();
+
+    // 作用域内的一个区间；detail 须在区间结束前保持有效
+    class TraceSpan
+    {
+    public:
+        explicit TraceSpan(const char* name, std::string_view detail = {})
+            : m_name(TraceEnabled() ? name : nullptr)
+            , m_detail(detail)
+            , m_start(m_name != nullptr ? TraceNow() : 0)
+        {
+        }
+
+        ~TraceSpan()
+        {
+            if (m_name != nullptr) {
+                RecordTraceSpan(m_name, m_start, TraceNow(), m_detail);
+            }
+        }
+
+        TraceSpan(const TraceSpan&)            = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+    private:
+        const char*      m_name;
+        std::string_view m_detail;
+        uint64_t         m_start;
+    };
+
+}  // namespace gotoslnx
@@ -0,0 +1,286 @@
+#include "work_stealing.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace gotoslnx
+{
+
+    struct Task
+    {
+        std::function<void()> fn;
+        TaskGroup*            group;
+    };
+
+    struct WorkStealingDeque::Ring
+    {
+        explicit Ring(int64_t capacity)
+            : capacity(capacity)
+            , slots(new std::atomic<Task*>[static_cast<size_t>(capacity)])
+        {
+        }
+
+        Task* Get(int64_t index) const { return slots[static_cast<size_t>(index & (capacity - 1))].load(std::memory_order_relaxed); }
+        void  Put(int64_t index, Task* task) { slots[static_cast<size_t>(index & (capacity - 1))].store(task, std::memory_order_relaxed); }
+
+        int64_t                               capacity;  // 2 的幂
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+    };
+
+    namespace
+    {
+
+        constexpr int64_t kInitialRingCapacity = 64;
+
+        thread_local const TaskScheduler* t_scheduler = nullptr;
+        thread_local size_t               t_worker    = 0;
+        thread_local uint32_t             t_random    = 0;
+        thread_local const TaskGroup*     t_running   = nullptr;  // 本线程正在执行的任务所属的组
+
+        uint32_t NextRandom()
+        {
+            // xorshift32，只用于打散窃取对象
+            uint32_t x = t_random != 0 ? t_random : static_cast<uint32_t>(t_worker * 2654435761u + 1);
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            t_random = x;
+            return x;
+        }
+
+    }  // namespace
+
+    WorkStealingDeque::WorkStealingDeque()
+    {
+        m_rings.push_back(std::make_unique<Ring>(kInitialRingCapacity));
+        m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque::~WorkStealingDeque() = default;
+
+    void WorkStealingDeque::Push(Task* task)
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top    = m_top.load(std::memory_order_acquire);
+        Ring*   ring   = m_ring.load(std::memory_order_relaxed);
+        if (bottom - top > ring->capacity - 1) {
+            auto grown = std::make_unique<Ring>(ring->capacity * 2);
+            for (int64_t index = top; index < bottom; ++index) {
+                grown->Put(index, ring->Get(index));
+            }
+            ring = grown.get();
+            m_rings.push_back(std::move(grown));
+            m_ring.store(ring, std::memory_order_release);
+        }
+        ring->Put(bottom, task);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    Task* WorkStealingDeque::Pop()
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Ring*   ring   = m_ring.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Task* task = ring->Get(bottom);
+        if (top == bottom) {
+            // 只剩最后一个，和窃取者竞争
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                task = nullptr;
+            }
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    Task* WorkStealingDeque::Steal()
+    {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = m_bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+        Task* task = m_ring.load(std::memory_order_acquire)->Get(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return task;
+    }
+
+    TaskScheduler::TaskScheduler(size_t threadCount)
+    {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (size_t i = 0; i < threadCount; ++i) {
+            m_deques.push_back(std::make_unique<WorkStealingDeque>());
+        }
+        m_outer        = t_scheduler;
+        m_outerWorker  = t_worker;
+        m_outerRunning = t_running;
+        t_scheduler    = this;
+        t_worker       = 0;
+        t_running      = nullptr;
+        for (size_t i = 1; i < threadCount; ++i) {
+            m_threads.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+
+    TaskScheduler::~TaskScheduler()
+    {
+        m_stop.store(true);
+        m_epoch.fetch_add(1);
+        m_epoch.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+        if (t_scheduler == this) {
+            t_scheduler = m_outer;
+            t_worker    = m_outerWorker;
+            t_running   = m_outerRunning;
+        }
+    }
+
+    size_t TaskScheduler::CurrentWorker() const
+    {
+        if (t_scheduler != this) {
+            throw std::runtime_error("只能在调度器的工作线程中提交任务。");
+        }
+        return t_worker;
+    }
+
+    void TaskScheduler::Spawn(TaskGroup& group, std::function<void()> fn)
+    {
+        size_t self = CurrentWorker();
+        group.m_parent.store(t_running, std::memory_order_relaxed);
+        group.m_pending.fetch_add(1, std::memory_order_relaxed);
+        m_deques[self]->Push(new Task { std::move(fn), &group });
+        m_epoch.fetch_add(1, std::memory_order_release);
+        m_epoch.notify_one();
+    }
+
+    void TaskScheduler::Wait(TaskGroup& group)
+    {
+        size_t self = CurrentWorker();
+        if (t_running != nullptr) {
+            WaitNested(group, self);
+        } else {
+            while (group.m_pending.load(std::memory_order_acquire) != 0) {
+                if (Task* task = FindTask(self)) {
+                    Execute(task);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        if (group.m_failure) {
+            std::exception_ptr failure = std::exchange(group.m_failure, nullptr);
+            std::rethrow_exception(failure);
+        }
+    }
+
+    // 本组的子任务都压在自己队列的底部，其上是外层任务留下的兄弟任务与顶层任务。
+    // 从底部弹出属于本组（或其派生组）的任务执行；遇到第一个不属于的就放回，此后队列里不会再有本组的任务，
+    // 只需等被窃走的那部分完成
+    void TaskScheduler::WaitNested(TaskGroup& group, size_t self)
+    {
+        while (group.m_pending.load(std::memory_order_acquire) != 0) {
+            Task* task = m_deques[self]->Pop();
+            if (task == nullptr) {
+                break;
+            }
+            const TaskGroup* owner = task->group;
+            while (owner != nullptr && owner != &group) {
+                owner = owner->m_parent.load(std::memory_order_relaxed);
+            }
+            if (owner == nullptr) {
+                m_deques[self]->Push(task);
+                break;
+            }
+            Execute(task);
+        }
+        while (group.m_pending.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    void TaskScheduler::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn)
+    {
+        grain = std::max<size_t>(grain, 1);
+        if (count <= grain) {
+            if (count != 0) {
+                fn(0, count);
+            }
+            return;
+        }
+        TaskGroup group;
+        for (size_t begin = 0; begin < count; begin += grain) {
+            size_t end = std::min(count, begin + grain);
+            Spawn(group, [&fn, begin, end] { fn(begin, end); });
+        }
+        Wait(group);
+    }
+
+    Task* TaskScheduler::FindTask(size_t self)
+    {
+        if (Task* task = m_deques[self]->Pop()) {
+            return task;
+        }
+        const size_t count = m_deques.size();
+        const size_t start = NextRandom() % count;
+        for (size_t offset = 0; offset < count; ++offset) {
+            size_t victim = (start + offset) % count;
+            if (victim == self) {
+                continue;
+            }
+            if (Task* task = m_deques[victim]->Steal()) {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    void TaskScheduler::Execute(Task* task)
+    {
+        TaskGroup&       group   = *task->group;
+        const TaskGroup* running = std::exchange(t_running, &group);
+        try {
+            task->fn();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(group.m_failureMutex);
+            if (!group.m_failure) {
+                group.m_failure = std::current_exception();
+            }
+        }
+        t_running = running;
+        // 先释放任务再计数，Wait 返回后不会再有捕获对象被析构
+        delete task;
+        group.m_pending.fetch_sub(1, std::memory_order_release);
+    }
+
+    void TaskScheduler::WorkerLoop(size_t index)
+    {
+        t_scheduler = this;
+        t_worker    = index;
+        SetTraceThreadName(fmt::format("worker {}", index));
+        while (!m_stop.load(std::memory_order_acquire)) {
+            uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+            if (Task* task = FindTask(index)) {
+                Execute(task);
+                continue;
+            }
+            m_epoch.wait(epoch, std::memory_order_acquire);
+        }
+    }
+
+}  // namespace gotoslnx
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    struct Task;
+
+    // Chase-Lev 双端队列：所有者在底部压入/弹出，其他线程从顶部窃取
+    class WorkStealingDeque
+    {
+    public:
+        WorkStealingDeque();
+        ~WorkStealingDeque();
+
+        WorkStealingDeque(const WorkStealingDeque&)            = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        void  Push(Task* task);  // 仅所有者
+        Task* Pop();             // 仅所有者
+        Task* Steal();           // 任意线程
+
+    private:
+        struct Ring;
+
+        std::atomic<int64_t>               m_top { 0 };
+        std::atomic<int64_t>               m_bottom { 0 };
+        std::atomic<Ring*>                 m_ring;
+        std::vector<std::unique_ptr<Ring>> m_rings;  // 扩容后旧数组可能仍被窃取者读取，留到析构时释放
+    };
+
+    // 一组待完成的任务；Wait 返回后可重复使用
+    class TaskGroup
+    {
+    public:
+        TaskGroup() = default;
+
+        TaskGroup(const TaskGroup&)            = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+    private:
+        friend class TaskScheduler;
+
+        std::atomic<size_t>           m_pending { 0 };
+        std::exception_ptr            m_failure;
+        std::mutex                    m_failureMutex;
+        std::atomic<const TaskGroup*> m_parent { nullptr };  // 提交任务时正在执行的任务所属的组，顶层提交时为空
+    };
+
+    // 工作窃取调度器。构造它的线程是 0 号工作者，只在 Wait 中执行任务。
+    // 顶层的 Wait 会执行或窃取任意任务；任务内部也可以继续 Spawn/Wait，这时等待期间只执行本组及其派生的子任务，
+    // 不会把无关的顶层任务嵌进来拖慢当前任务，本组被其他线程窃走的子任务由它们完成。
+    // 同一线程上可以嵌套构造调度器：内层存活期间本线程归内层，析构时交还外层
+    class TaskScheduler
+    {
+    public:
+        explicit TaskScheduler(size_t threadCount = 0);  // 0 表示按硬件线程数
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler&)            = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        // 只能在构造线程或任务内部调用；一个组的任务应由同一个任务（或顶层）提交
+        void Spawn(TaskGroup& group, std::function<void()> fn);
+        // 任务抛出的第一个异常在这里重新抛出
+        void Wait(TaskGroup& group);
+
+        // 把 [0, count) 切成不超过 grain 的区间，每段一个可被窃取的子任务
+        void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+        size_t WorkerCount() const { return m_deques.size(); }
+
+    private:
+        Task*  FindTask(size_t self);
+        void   WaitNested(TaskGroup& group, size_t self);
+        void   Execute(Task* task);
+        void   WorkerLoop(size_t index);
+        size_t CurrentWorker() const;
+
+        std::vector<std::unique_ptr<WorkStealingDeque>> m_deques;
+        std::vector<std::thread>                        m_threads;
+        std::atomic<bool>                               m_stop { false };
+        std::atomic<uint32_t>                           m_epoch { 0 };        // 每次 Spawn 递增，空闲线程在此等待
+        const TaskScheduler*                            m_outer { nullptr };  // 构造线程上原先的调度器，析构时恢复
+        size_t                                          m_outerWorker { 0 };
+        const TaskGroup*                                m_outerRunning { nullptr };
+    };
+
+}  // namespace gotoslnx
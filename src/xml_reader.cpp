@@ -0,0 +1,238 @@
+#include "xml_reader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        bool IsXmlSpace(char ch)
+        {
+            return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+        }
+
+        bool IsNameChar(char ch)
+        {
+            return !IsXmlSpace(ch) && ch != '=' && ch != '>' && ch != '/' && ch != '<' && ch != '"' && ch != '\'';
+        }
+
+        void AppendUtf8(std::string& out, uint32_t codePoint)
+        {
+            if (codePoint < 0x80) {
+                out.push_back(static_cast<char>(codePoint));
+            } else if (codePoint < 0x800) {
+                out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+                out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            } else if (codePoint < 0x10000) {
+                out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            } else {
+                out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+            }
+        }
+
+    }  // namespace
+
+    XmlReader::XmlReader(std::string_view text) : m_text(text)
+    {
+        if (m_text.substr(0, 3) == "\xEF\xBB\xBF") {
+            m_pos = 3;
+        }
+    }
+
+    size_t XmlReader::Line() const
+    {
+        return static_cast<size_t>(std::count(m_text.begin(), m_text.begin() + static_cast<std::ptrdiff_t>(m_pos), '\n')) + 1;
+    }
+
+    void XmlReader::Fail(std::string_view message) const
+    {
+        throw std::runtime_error(fmt::format("解析 XML 失败（第 {} 行）: {}", Line(), message));
+    }
+
+    void XmlReader::SkipPast(std::string_view terminator)
+    {
+        auto end = m_text.find(terminator, m_pos);
+        if (end == std::string_view::npos) {
+            Fail(fmt::format("缺少 {}", terminator));
+        }
+        m_pos = end + terminator.size();
+    }
+
+    void XmlReader::SkipWhitespace()
+    {
+        while (m_pos < m_text.size() && IsXmlSpace(m_text[m_pos])) {
+            ++m_pos;
+        }
+    }
+
+    std::string_view XmlReader::ReadName()
+    {
+        size_t start = m_pos;
+        while (m_pos < m_text.size() && IsNameChar(m_text[m_pos])) {
+            ++m_pos;
+        }
+        if (m_pos == start) {
+            Fail("缺少名称");
+        }
+        return m_text.substr(start, m_pos - start);
+    }
+
+    std::string XmlReader::DecodeEntities(std::string_view raw) const
+    {
+        std::string out;
+        out.reserve(raw.size());
+        size_t pos = 0;
+        while (pos < raw.size()) {
+            auto amp = raw.find('&', pos);
+            if (amp == std::string_view::npos) {
+                out.append(raw.substr(pos));
+                break;
+            }
+            out.append(raw.substr(pos, amp - pos));
+            auto semi = raw.find(';', amp);
+            if (semi == std::string_view::npos) {
+                Fail("实体缺少 ';'");
+            }
+            std::string_view entity = raw.substr(amp + 1, semi - amp - 1);
+            if (entity == "lt") {
+                out.push_back('<');
+            } else if (entity == "gt") {
+                out.push_back('>');
+            } else if (entity == "amp") {
+                out.push_back('&');
+            } else if (entity == "quot") {
+                out.push_back('"');
+            } else if (entity == "apos") {
+                out.push_back('\'');
+            } else if (entity.size() > 1 && entity[0] == '#') {
+                bool     hex       = entity[1] == 'x' || entity[1] == 'X';
+                uint32_t codePoint = 0;
+                for (char ch : entity.substr(hex ? 2 : 1)) {
+                    int digit = -1;
+                    if (ch >= '0' && ch <= '9') {
+                        digit = ch - '0';
+                    } else if (hex && ch >= 'a' && ch <= 'f') {
+                        digit = ch - 'a' + 10;
+                    } else if (hex && ch >= 'A' && ch <= 'F') {
+                        digit = ch - 'A' + 10;
+                    }
+                    if (digit < 0 || codePoint > 0x10FFFF) {
+                        Fail(fmt::format("无效的字符引用 &{};", entity));
+                    }
+                    codePoint = codePoint * (hex ? 16 : 10) + static_cast<uint32_t>(digit);
+                }
+                AppendUtf8(out, codePoint);
+            } else {
+                Fail(fmt::format("未知实体 &{};", entity));
+            }
+            pos = semi + 1;
+        }
+        return out;
+    }
+
+    bool XmlReader::Read()
+    {
+        if (m_pendingEnd) {
+            m_pendingEnd = false;
+            m_type       = NodeType::EndElement;
+            m_stack.pop_back();
+            return true;
+        }
+
+        m_attributes.clear();
+        while (true) {
+            auto open = m_text.find('<', m_pos);
+            if (open == std::string_view::npos) {
+                if (!m_stack.empty()) {
+                    Fail(fmt::format("元素 <{}> 未闭合", m_stack.back()));
+                }
+                m_pos  = m_text.size();
+                m_type = NodeType::None;
+                return false;
+            }
+            m_pos                 = open;
+            std::string_view rest = m_text.substr(m_pos);
+            if (rest.substr(0, 4) == "<!--") {
+                SkipPast("-->");
+            } else if (rest.substr(0, 9) == "<![CDATA[") {
+                SkipPast("]]>");
+            } else if (rest.substr(0, 2) == "<?" || rest.substr(0, 2) == "<!") {
+                SkipPast(">");
+            } else if (rest.substr(0, 2) == "</") {
+                m_pos += 2;
+                m_name = ReadName();
+                SkipWhitespace();
+                if (m_pos >= m_text.size() || m_text[m_pos] != '>') {
+                    Fail("结束标签缺少 '>'");
+                }
+                ++m_pos;
+                if (m_stack.empty() || m_stack.back() != m_name) {
+                    Fail(fmt::format("结束标签 </{}> 不匹配", m_name));
+                }
+                m_stack.pop_back();
+                m_type = NodeType::EndElement;
+                return true;
+            } else {
+                ++m_pos;
+                m_name = ReadName();
+                while (true) {
+                    SkipWhitespace();
+                    if (m_pos >= m_text.size()) {
+                        Fail(fmt::format("元素 <{}> 不完整", m_name));
+                    }
+                    if (m_text[m_pos] == '>') {
+                        ++m_pos;
+                        break;
+                    }
+                    if (m_text.substr(m_pos, 2) == "/>") {
+                        m_pos += 2;
+                        m_pendingEnd = true;
+                        break;
+                    }
+                    std::string_view attrName = ReadName();
+                    SkipWhitespace();
+                    if (m_pos >= m_text.size() || m_text[m_pos] != '=') {
+                        Fail(fmt::format("属性 {} 缺少 '='", attrName));
+                    }
+                    ++m_pos;
+                    SkipWhitespace();
+                    if (m_pos >= m_text.size() || (m_text[m_pos] != '"' && m_text[m_pos] != '\'')) {
+                        Fail(fmt::format("属性 {} 缺少引号", attrName));
+                    }
+                    char quote = m_text[m_pos++];
+                    auto close = m_text.find(quote, m_pos);
+                    if (close == std::string_view::npos) {
+                        Fail(fmt::format("属性 {} 未闭合", attrName));
+                    }
+                    m_attributes.emplace_back(attrName, DecodeEntities(m_text.substr(m_pos, close - m_pos)));
+                    m_pos = close + 1;
+                }
+                m_stack.push_back(m_name);
+                m_type = NodeType::StartElement;
+                return true;
+            }
+        }
+    }
+
+    std::optional<std::string> XmlReader::Attribute(std::string_view name) const
+    {
+        for (const auto& [attrName, value] : m_attributes) {
+            if (attrName == name) {
+                return value;
+            }
+        }
+        return std::nullopt;
+    }
+
+}  // namespace gotoslnx
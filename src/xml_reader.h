@@ -0,0 +1,50 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 顺序拉取式 XML 读取器：不构建 DOM，仅支持 .slnx 用到的子集
+    class XmlReader
+    {
+    public:
+        enum class NodeType
+        {
+            None,
+            StartElement,
+            EndElement,
+        };
+
+        explicit XmlReader(std::string_view text);
+
+        // 自闭合元素会依次产出 StartElement 与 EndElement
+        bool Read();
+
+        NodeType                   Type() const { return m_type; }
+        std::string_view           Name() const { return m_name; }
+        size_t                     Depth() const { return m_stack.size(); }
+        size_t                     Line() const;
+        std::optional<std::string> Attribute(std::string_view name) const;
+
+    private:
+        void             Fail(std::string_view message) const;
+        void             SkipPast(std::string_view terminator);
+        void             SkipWhitespace();
+        std::string_view ReadName();
+        std::string      DecodeEntities(std::string_view raw) const;
+
+        std::string_view                                      m_text;
+        size_t                                                m_pos  = 0;
+        NodeType                                              m_type = NodeType::None;
+        std::string_view                                      m_name;
+        std::vector<std::pair<std::string_view, std::string>> m_attributes;
+        std::vector<std::string_view>                         m_stack;
+        bool                                                  m_pendingEnd = false;
+    };
+
+}  // namespace gotoslnx
@@ -0,0 +1,201 @@
+#include "xml_writer.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GOTOSLNX_XML_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define GOTOSLNX_XML_NEON 1
+#endif
+
+namespace gotoslnx
+{
+
+    namespace
+    {
+
+        std::string_view EntityFor(char c)
+        {
+            switch (c) {
+                case '&':
+                    return "&amp;";
+                case '<':
+                    return "&lt;";
+                case '>':
+                    return "&gt;";
+                case '"':
+                    return "&quot;";
+                case '\'':
+                    return "&apos;";
+                default:
+                    return {};
+            }
+        }
+
+        // 需要停下检查的字节：五个转义字符与控制字符。控制字符大多不是合法的 XML 字符，同样检出交给慢路径；
+        // 目前与 tinyxml2 一致原样输出
+        constexpr std::array<bool, 256> kAttention = [] {
+            std::array<bool, 256> table{};
+            for (size_t c = 0; c < 0x20; ++c) {
+                table[c] = true;
+            }
+            for (unsigned char c : std::string_view("&<>\"'")) {
+                table[c] = true;
+            }
+            return table;
+        }();
+
+#if defined(GOTOSLNX_XML_SSE2)
+        constexpr int kMaskBitsPerByte = 1;
+
+        // 16 字节中需要检查的字节，每字节一位
+        uint32_t AttentionMask(const char* block)
+        {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+            __m128i       hit   = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('&')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('<')));
+            hit = _mm_or_si128(hit, _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('>')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('"'))));
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\'')));
+            // 无符号比较 chunk <= 0x1F：min(chunk, 0x1F) == chunk
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi8(_mm_min_epu8(chunk, _mm_set1_epi8(0x1F)), chunk));
+            return static_cast<uint32_t>(_mm_movemask_epi8(hit));
+        }
+#elif defined(GOTOSLNX_XML_NEON)
+        constexpr int kMaskBitsPerByte = 4;
+
+        // 16 字节中需要检查的字节，每字节收窄成 4 位
+        uint64_t AttentionMask(const char* block)
+        {
+            const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(block));
+            uint8x16_t       hit   = vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('&')), vceqq_u8(chunk, vdupq_n_u8('<')));
+            hit = vorrq_u8(hit, vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('>')), vceqq_u8(chunk, vdupq_n_u8('"'))));
+            hit = vorrq_u8(hit, vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('\'')), vcleq_u8(chunk, vdupq_n_u8(0x1F))));
+            return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+        }
+#endif
+
+        // 返回 from 起第一个需要检查的位置，没有则返回 text.size()
+        size_t FindAttention(std::string_view text, size_t from)
+        {
+            const char* data = text.data();
+            size_t      size = text.size();
+#if defined(GOTOSLNX_XML_SSE2) || defined(GOTOSLNX_XML_NEON)
+            if (size - from >= 16) {
+                for (; from + 16 <= size; from += 16) {
+                    if (auto mask = AttentionMask(data + from); mask != 0) {
+                        return from + static_cast<size_t>(std::countr_zero(mask) / kMaskBitsPerByte);
+                    }
+                }
+                if (from == size) {
+                    return size;
+                }
+                // 剩余不足 16 字节时退回到末尾重叠加载一次，移掉已确认干净的前缀，不越过 string_view 的末尾读取
+                size_t last = size - 16;
+                auto   mask = AttentionMask(data + last) >> ((from - last) * kMaskBitsPerByte);
+                return mask != 0 ? from + static_cast<size_t>(std::countr_zero(mask) / kMaskBitsPerByte) : size;
+            }
+#endif
+            for (; from < size; ++from) {
+                if (kAttention[static_cast<unsigned char>(data[from])]) {
+                    return from;
+                }
+            }
+            return size;
+        }
+
+    }  // namespace
+
+    void AppendXmlEscaped(std::string& out, std::string_view text)
+    {
+        // 干净的区间整段复制，只在命中的字节上走逐字节判断
+        size_t runStart = 0;
+        for (size_t index = FindAttention(text, 0); index < text.size(); index = FindAttention(text, index + 1)) {
+            std::string_view entity = EntityFor(text[index]);
+            if (entity.empty()) {
+                continue;
+            }
+            out.append(text.substr(runStart, index - runStart));
+            out.append(entity);
+            runStart = index + 1;
+        }
+        out.append(text.substr(runStart));
+    }
+
+    void AppendXmlEscapedScalar(std::string& out, std::string_view text)
+    {
+        size_t runStart = 0;
+        for (size_t index = 0; index < text.size(); ++index) {
+            std::string_view entity = EntityFor(text[index]);
+            if (entity.empty()) {
+                continue;
+            }
+            out.append(text.substr(runStart, index - runStart));
+            out.append(entity);
+            runStart = index + 1;
+        }
+        out.append(text.substr(runStart));
+    }
+
+    XmlWriter::XmlWriter(std::string& out, size_t depth, bool atDocumentStart)
+        : m_out(out)
+        , m_baseDepth(depth)
+        , m_firstElement(atDocumentStart)
+    {
+    }
+
+    void XmlWriter::OpenElement(std::string_view name)
+    {
+        SealElement();
+        if (!m_firstElement) {
+            m_out.push_back('\n');
+            m_out.append(Depth() * 4, ' ');
+        }
+        m_out.push_back('<');
+        m_out.append(name);
+        m_stack.push_back(name);
+        m_firstElement      = false;
+        m_elementJustOpened = true;
+    }
+
+    void XmlWriter::Attribute(std::string_view name, std::string_view value)
+    {
+        // 与以 C 字符串传值的 tinyxml2 一致，内嵌的 NUL 截断属性值
+        value = value.substr(0, value.find('\0'));
+        m_out.push_back(' ');
+        m_out.append(name);
+        m_out.append("=\"");
+        AppendXmlEscaped(m_out, value);
+        m_out.push_back('"');
+    }
+
+    void XmlWriter::SealElement()
+    {
+        if (m_elementJustOpened) {
+            m_out.push_back('>');
+            m_elementJustOpened = false;
+        }
+    }
+
+    void XmlWriter::CloseElement()
+    {
+        std::string_view name = m_stack.back();
+        m_stack.pop_back();
+        if (m_elementJustOpened) {
+            m_out.append("/>");
+        } else {
+            m_out.push_back('\n');
+            m_out.append(Depth() * 4, ' ');
+            m_out.append("</");
+            m_out.append(name);
+            m_out.push_back('>');
+        }
+        if (Depth() == 0) {
+            m_out.push_back('\n');
+        }
+        m_elementJustOpened = false;
+    }
+
+}  // namespace gotoslnx
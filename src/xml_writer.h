@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gotoslnx
+{
+
+    // 按属性值的规则转义后追加：& < > " ' 换成实体，其余字节原样复制。
+    // 以 SSE2/NEON 每次扫描 16 字节，不需要转义的区间整段复制
+    void AppendXmlEscaped(std::string& out, std::string_view text);
+    // 逐字节的参考实现，输出与 AppendXmlEscaped 相同，供基准对比
+    void AppendXmlEscapedScalar(std::string& out, std::string_view text);
+
+    // 直接生成文本的 XML 写出器，格式与 tinyxml2::XMLPrinter 的缩进模式逐字节相同：每层缩进 4 个空格，
+    // 没有子元素的元素自闭合，顶层元素结束后换行。可以从任意深度开始，单独渲染文档中的一段
+    class XmlWriter
+    {
+    public:
+        // depth 为第一个元素的深度；atDocumentStart 为 false 时第一个元素前同样换行缩进，用于渲染文档中间的片段
+        explicit XmlWriter(std::string& out, size_t depth = 0, bool atDocumentStart = true);
+
+        // name 须在元素结束前保持有效
+        void OpenElement(std::string_view name);
+        void Attribute(std::string_view name, std::string_view value);
+        // 子元素由别处单独渲染时调用：补全开始标签，CloseElement 随后写出结束标签
+        void SealElement();
+        void CloseElement();
+
+    private:
+        size_t Depth() const { return m_baseDepth + m_stack.size(); }
+
+        std::string&                  m_out;
+        std::vector<std::string_view> m_stack;
+        size_t                        m_baseDepth;
+        bool                          m_firstElement;
+        bool                          m_elementJustOpened = false;
+    };
+
+}  // namespace gotoslnx
@@ -0,0 +1,159 @@
+#include "guid_util.h"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+using namespace gotoslnx;
+
+namespace
+{
+
+    // 覆盖全 0、全 F 与大小写混合三种底稿，改动某一位时其余位置的取值各不相同
+    constexpr std::string_view kBaseGuids[] = {
+        "{00000000-0000-0000-0000-000000000000}",
+        "{FFFFFFFF-FFFF-FFFF-FFFF-FFFFFFFFFFFF}",
+        "{a1B2c3D4-e5F6-0718-293A-4b5C6d7E8f90}",
+    };
+
+    constexpr size_t kRandomRoundTrips = 100000;
+
+    size_t g_failures = 0;
+
+    void Fail(const std::string& message)
+    {
+        if (++g_failures <= 20) {
+            fmt::print(stderr, "失败: {}\n", message);
+        }
+    }
+
+    std::string Printable(std::string_view text)
+    {
+        std::string out;
+        for (char ch : text) {
+            auto byte = static_cast<unsigned char>(ch);
+            out += std::isprint(byte) ? std::string(1, ch) : fmt::format("\\x{:02X}", byte);
+        }
+        return out;
+    }
+
+    // 逐字符的参考解码，按文本顺序取 32 个十六进制位
+    GuidBytes ReferenceDecode(std::string_view text)
+    {
+        GuidBytes guid {};
+        size_t    nibble = 0;
+        for (char ch : text.substr(1, kSlnxGuidLength)) {
+            if (ch == '-') {
+                continue;
+            }
+            auto    byte  = static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(ch)));
+            uint8_t value = static_cast<uint8_t>(byte <= '9' ? byte - '0' : byte - 'a' + 10);
+            guid[nibble / 2] |= static_cast<uint8_t>(nibble % 2 == 0 ? value << 4 : value);
+            ++nibble;
+        }
+        return guid;
+    }
+
+    std::string LowerSlnxForm(std::string_view text)
+    {
+        std::string lower(text.substr(1, kSlnxGuidLength));
+        for (auto& ch : lower) {
+            ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        }
+        return lower;
+    }
+
+    // 每个位置换成每一个字节值，DecodeBracedGuid 的判定须与 IsGuidText 一致；能解码时再核对字节与小写编码
+    void CheckEveryByteAtEveryPosition(std::string_view base)
+    {
+        std::string text(base);
+        for (size_t position = 0; position < kBracedGuidLength; ++position) {
+            for (int value = 0; value < 256; ++value) {
+                text[position] = static_cast<char>(value);
+                bool      expected = text.front() == '{' && text.back() == '}' && IsGuidText(text);
+                GuidBytes decoded {};
+                bool      actual = DecodeBracedGuid(text, decoded);
+                if (actual != expected) {
+                    Fail(fmt::format("{} 判定为 {}，IsGuidText 为 {}", Printable(text), actual, expected));
+                    continue;
+                }
+                if (!actual) {
+                    continue;
+                }
+                if (decoded != ReferenceDecode(text)) {
+                    Fail(fmt::format("{} 解码结果与逐字符参考不同", Printable(text)));
+                }
+                char encoded[kSlnxGuidLength];
+                EncodeGuidLower(decoded, encoded);
+                if (std::string_view(encoded, kSlnxGuidLength) != LowerSlnxForm(text)) {
+                    Fail(fmt::format("{} 编码为 {}", Printable(text), std::string_view(encoded, kSlnxGuidLength)));
+                }
+            }
+            text[position] = base[position];
+        }
+    }
+
+    // 编码后分别以小写、大写加花括号再解码，须得到原来的字节
+    void CheckRoundTrip(const GuidBytes& guid)
+    {
+        char encoded[kSlnxGuidLength];
+        EncodeGuidLower(guid, encoded);
+        std::string lower = "{" + std::string(encoded, kSlnxGuidLength) + "}";
+        std::string upper = lower;
+        for (auto& ch : upper) {
+            ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+        }
+        for (const std::string& text : { lower, upper }) {
+            GuidBytes decoded {};
+            if (!DecodeBracedGuid(text, decoded) || decoded != guid) {
+                Fail(fmt::format("{} 往返后不一致", text));
+            }
+            if (!IsGuidText(text)) {
+                Fail(fmt::format("{} 不被 IsGuidText 接受", text));
+            }
+        }
+    }
+
+    void CheckRoundTrips()
+    {
+        // 每个字节位置取遍 256 个值，其余字节为 0 与 0xFF 各一轮
+        for (uint8_t fill : { uint8_t(0x00), uint8_t(0xFF) }) {
+            for (size_t index = 0; index < GuidBytes {}.size(); ++index) {
+                for (int value = 0; value < 256; ++value) {
+                    GuidBytes guid;
+                    guid.fill(fill);
+                    guid[index] = static_cast<uint8_t>(value);
+                    CheckRoundTrip(guid);
+                }
+            }
+        }
+        std::mt19937_64 random(20260117);
+        for (size_t i = 0; i < kRandomRoundTrips; ++i) {
+            GuidBytes guid;
+            for (auto& byte : guid) {
+                byte = static_cast<uint8_t>(random());
+            }
+            CheckRoundTrip(guid);
+        }
+    }
+
+}  // namespace
+
+int main()
+{
+    for (std::string_view base : kBaseGuids) {
+        CheckEveryByteAtEveryPosition(base);
+    }
+    CheckRoundTrips();
+    if (g_failures != 0) {
+        fmt::print(stderr, "共 {} 处失败\n", g_failures);
+        return 1;
+    }
+    fmt::print("GUID 内核检查通过\n");
+    return 0;
+}